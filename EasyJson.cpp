@@ -5,19 +5,71 @@
 
 #include "EasyJson.hpp"
 #include <assert.h>
+#include <stdint.h>
 #include <errno.h>
 #include <stdlib.h>
 #include <errno.h>
 #include <math.h>
 #include <string.h>
 #include <stdio.h>
+#include <thread>
+#include <atomic>
+#ifdef _WIN32
+#include <io.h>
+#define write _write
+typedef int ssize_t;
+#else
+#include <unistd.h>
+#endif
+
+/* EASYJSON_NO_SIMD 可关闭向量化扫描, 便于对比 */
+#if !defined(EASYJSON_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64))
+#define EASYJSON_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__linux__)
+#define EASYJSON_AVX2   /* 运行时检测 CPU 后启用 */
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+static inline unsigned CTZ(unsigned x) { unsigned long i; _BitScanForward(&i, x); return i; }
+static inline int CLZ64(unsigned long long x) { unsigned long i; _BitScanReverse64(&i, x); return 63 - (int)i; }
+static inline unsigned CTZ64(unsigned long long x) { unsigned long i; _BitScanForward64(&i, x); return i; }
+#define POPCOUNT64(x) ((unsigned)__popcnt64(x))
+#else
+#define CTZ(x) ((unsigned)__builtin_ctz(x))
+#define CLZ64(x) __builtin_clzll(x)
+#define CTZ64(x) ((unsigned)__builtin_ctzll(x))
+#define POPCOUNT64(x) ((unsigned)__builtin_popcountll(x))
+#endif
 
 #ifndef PARSE_STACK_INIT_SIZE
 #define PARSE_STACK_INIT_SIZE 256
 #endif
 
+/* 数组/对象的最大嵌套层数, 超过时返回 PARSE_TOO_DEEP */
+#ifndef PARSE_MAX_DEPTH
+#define PARSE_MAX_DEPTH 1024
+#endif
+
+#ifndef ARENA_CHUNK_INIT_SIZE
+#define ARENA_CHUNK_INIT_SIZE 4096
+#endif
+
+#ifndef KEY_POOL_INIT_SIZE
+#define KEY_POOL_INIT_SIZE 64     /* 须为 2 的幂 */
+#endif
+
+/* 成员数不少于此值时 find_object_value 建立哈希索引 */
+#ifndef OBJECT_INDEX_THRESHOLD
+#define OBJECT_INDEX_THRESHOLD 8
+#endif
+
 namespace EasyJson {
-#define EXPECT(c, ch) do { assert(*c->json == (ch)); c->json++; } while(0)
+#define EXPECT(c, ch) do { assert(c->json != c->end && *c->json == (ch)); c->json++; } while(0)
+#define PEEK(c) ((c)->json != (c)->end ? *(c)->json : '\0')  /* 输入结束时返回 '\0' */
 #define ISDIGIT(ch) ((ch) >= '0' && (ch) <= '9')
 #define ISDIGIT1TO9(ch) ((ch) >= '1' && (ch) <= '9')
 #define PUTC(c, ch) do { *(char*)context_push(c, sizeof(char)) = (ch); } while(0)
@@ -26,13 +78,93 @@ namespace EasyJson {
 struct context
 {
     const char* json;
+    const char* end;    /* 输入的结尾, 不依赖 '\0' */
     char* stack;
     size_t size, top;
+    arena* a;
+    int insitu;     /* 字符串原地解析到输入缓冲区 */
+    key_pool* keys; /* 键取自键池 */
+    sink_func sink; /* 输出到 sink 时栈满即交给 sink 并清空, 不再增长 */
+    int owned;      /* sink 模式下调用方的缓冲区放不下一次写入, 已改用自己分配的栈 */
+    void* user;
+    int failed;     /* sink 返回过 0 */
+};
+
+struct arena_chunk
+{
+    arena_chunk* next;
 };
 
+#define ARENA_ALIGN(n) (((n) + sizeof(void*) - 1) & ~(sizeof(void*) - 1))
+
+void arena_init(arena* a, void* buf, size_t size) {
+    assert(a != nullptr && (buf != nullptr || size == 0));
+    a->cur = (char*)buf;
+    a->end = (char*)buf + size;
+    a->chunks = nullptr;
+    a->chunk_size = ARENA_CHUNK_INIT_SIZE;
+}
+
+void* arena_alloc(arena* a, size_t size) {
+    char* ret;
+    assert(a != nullptr);
+    size = ARENA_ALIGN(size);
+    ret = (char*)ARENA_ALIGN((size_t)a->cur);
+    if (a->cur == nullptr || ret > a->end || size > (size_t)(a->end - ret)) {
+        size_t n = a->chunk_size;
+        arena_chunk* chunk;
+        while (n < size + sizeof(arena_chunk))
+            n += n >> 1;
+        chunk = (arena_chunk*)malloc(n);
+        chunk->next = a->chunks;
+        a->chunks = chunk;
+        a->chunk_size += a->chunk_size >> 1;  /* 块大小按 1.5 倍增长 */
+        ret = (char*)chunk + ARENA_ALIGN(sizeof(arena_chunk));
+        a->end = (char*)chunk + n;
+    }
+    a->cur = ret + size;
+    return ret;
+}
+
+void arena_release(arena* a) {
+    assert(a != nullptr);
+    while (a->chunks) {
+        arena_chunk* next = a->chunks->next;
+        free(a->chunks);
+        a->chunks = next;
+    }
+    a->cur = a->end = nullptr;
+    a->chunk_size = ARENA_CHUNK_INIT_SIZE;
+}
+
+/* 解析出的节点/字符串存储, arena 模式下从内存池分配 */
+static void* context_alloc(context* c, size_t size) {
+    return c->a ? arena_alloc(c->a, size) : malloc(size);
+}
+
+static void context_free_key(context* c, char* k) {
+    if (!c->a && !c->insitu && !c->keys)
+        free(k);
+}
+
+static void context_flush(context* c) {
+    if (!c->failed && c->top && !c->sink(c->user, c->stack, c->top))
+        c->failed = 1;
+    c->top = 0;
+}
+
 static void* context_push(context* c, size_t size) {
     void* ret;
     assert(size > 0);
+    if (c->top + size >= c->size && c->sink) {
+        context_flush(c);
+        /* 调用方的缓冲区不能 realloc, 放不下时换成自己的栈 */
+        if (size >= c->size && !c->owned) {
+            c->stack = nullptr;
+            c->size = 0;
+            c->owned = 1;
+        }
+    }
     if (c->top + size >= c->size) {
         if (c->size == 0)
             c->size = PARSE_STACK_INIT_SIZE;
@@ -50,58 +182,855 @@ static void* context_pop(context* c, size_t size) {
     return c->stack + (c->top -= size);
 }
 
-static void parse_whitespace(context* c) {
-    const char *p = c->json;
-    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
+#define ISWHITESPACE(ch) ((ch) == ' ' || (ch) == '\t' || (ch) == '\n' || (ch) == '\r')
+
+static const char* skip_whitespace_scalar(const char* p, const char* end) {
+    while (p != end && ISWHITESPACE(*p))
+        p++;
+    return p;
+}
+
+#ifdef EASYJSON_SSE2
+/* 每次比较 16 字节, 返回第一个非空白字符的位置 */
+static const char* skip_whitespace_sse2(const char* p, const char* end) {
+    const __m128i sp = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t');
+    const __m128i lf = _mm_set1_epi8('\n'), cr = _mm_set1_epi8('\r');
+    for (; end - p >= 16; p += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)p);
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, sp), _mm_cmpeq_epi8(x, tab)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(x, lf), _mm_cmpeq_epi8(x, cr)));
+        unsigned mask = ~(unsigned)_mm_movemask_epi8(ws) & 0xFFFF;
+        if (mask)
+            return p + CTZ(mask);
+    }
+    return skip_whitespace_scalar(p, end);
+}
+#endif
+
+#ifdef EASYJSON_AVX2
+__attribute__((target("avx2")))
+static const char* skip_whitespace_avx2(const char* p, const char* end) {
+    const __m256i sp = _mm256_set1_epi8(' '), tab = _mm256_set1_epi8('\t');
+    const __m256i lf = _mm256_set1_epi8('\n'), cr = _mm256_set1_epi8('\r');
+    for (; end - p >= 32; p += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)p);
+        __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, sp), _mm256_cmpeq_epi8(x, tab)),
+                                     _mm256_or_si256(_mm256_cmpeq_epi8(x, lf), _mm256_cmpeq_epi8(x, cr)));
+        unsigned mask = ~(unsigned)_mm256_movemask_epi8(ws);
+        if (mask)
+            return p + CTZ(mask);
+    }
+    return skip_whitespace_sse2(p, end);
+}
+
+#endif
+
+/*
+字符串扫描: 返回第一个 '"'、'\\' 或控制字符的位置, 之前的字节可整段拷贝
+*/
+#define ISSTRINGSPECIAL(ch) ((ch) == '\"' || (ch) == '\\' || (unsigned char)(ch) < 0x20)
+
+static const char* scan_string_scalar(const char* p, const char* end) {
+    /* SWAR: 一次检查 8 字节, 命中后再逐字节定位 */
+    const uint64_t ones = 0x0101010101010101ULL, highs = 0x8080808080808080ULL;
+    for (; end - p >= 8; p += 8) {
+        uint64_t x, q, b;
+        memcpy(&x, p, 8);
+        q = x ^ (ones * '"');
+        b = x ^ (ones * '\\');
+        if (((q - ones) & ~q & highs) | ((b - ones) & ~b & highs) | ((x - ones * 0x20) & ~x & highs))
+            break;
+    }
+    while (p != end && !ISSTRINGSPECIAL(*p))
         p++;
+    return p;
+}
+
+#ifdef EASYJSON_SSE2
+static const char* scan_string_sse2(const char* p, const char* end) {
+    const __m128i quote = _mm_set1_epi8('"'), slash = _mm_set1_epi8('\\'), ctrl = _mm_set1_epi8(0x1F);
+    for (; end - p >= 16; p += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)p);
+        __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, quote), _mm_cmpeq_epi8(x, slash)),
+                                       _mm_cmpeq_epi8(_mm_min_epu8(x, ctrl), x));   /* x <= 0x1F */
+        unsigned mask = (unsigned)_mm_movemask_epi8(special);
+        if (mask)
+            return p + CTZ(mask);
+    }
+    return scan_string_scalar(p, end);
+}
+#endif
+
+#ifdef EASYJSON_AVX2
+__attribute__((target("avx2")))
+static const char* scan_string_avx2(const char* p, const char* end) {
+    const __m256i quote = _mm256_set1_epi8('"'), slash = _mm256_set1_epi8('\\'), ctrl = _mm256_set1_epi8(0x1F);
+    for (; end - p >= 32; p += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)p);
+        __m256i special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, quote), _mm256_cmpeq_epi8(x, slash)),
+                                          _mm256_cmpeq_epi8(_mm256_min_epu8(x, ctrl), x));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(special);
+        if (mask)
+            return p + CTZ(mask);
+    }
+    return scan_string_sse2(p, end);
+}
+#endif
+
+typedef const char* (*scan_func)(const char*, const char*);
+
+#ifdef EASYJSON_AVX2
+static int cpu_has_avx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+/*
+指针常量初始化为 resolve, 第一次调用时按 CPU 选择实现并替换自己;
+不依赖动态初始化, 其他翻译单元的静态构造函数中解析也能用
+*/
+static const char* skip_whitespace_resolve(const char* p, const char* end);
+static const char* scan_string_resolve(const char* p, const char* end);
+static std::atomic<scan_func> skip_whitespace_impl(skip_whitespace_resolve);
+static std::atomic<scan_func> scan_string_impl(scan_string_resolve);
+
+static const char* skip_whitespace_resolve(const char* p, const char* end) {
+    scan_func f = cpu_has_avx2() ? skip_whitespace_avx2 : skip_whitespace_sse2;
+    skip_whitespace_impl.store(f, std::memory_order_relaxed);
+    return f(p, end);
+}
+
+static const char* scan_string_resolve(const char* p, const char* end) {
+    scan_func f = cpu_has_avx2() ? scan_string_avx2 : scan_string_sse2;
+    scan_string_impl.store(f, std::memory_order_relaxed);
+    return f(p, end);
+}
+
+#define skip_whitespace (skip_whitespace_impl.load(std::memory_order_relaxed))
+#define scan_string (scan_string_impl.load(std::memory_order_relaxed))
+#elif defined(EASYJSON_SSE2)
+#define skip_whitespace skip_whitespace_sse2
+#define scan_string scan_string_sse2
+#else
+#define skip_whitespace skip_whitespace_scalar
+#define scan_string scan_string_scalar
+#endif
+
+static void parse_whitespace(context* c) {
+    const char *p = c->json, *end = c->end;
+    /* 紧凑输入里空白很少且很短, 前两个字节逐个判断, 更长的空白再走向量化扫描 */
+    if (p == end || !ISWHITESPACE(*p))
+        return;
+    if (++p != end && ISWHITESPACE(*p))
+        p = skip_whitespace(p + 1, end);
     c->json = p;    
 }
 
 /*
 解析null/true/false
 */
-static int parse_literal(context* c, EasyJson::value* v, const char* literal, type Type) {
+static int parse_literal(context* c, const char* literal) {
     size_t i;
     EXPECT(c, literal[0]);
     for (i = 0; literal[i+1]; i++)
-        if (c->json[i] != literal[i+1])
+        if (c->json + i == c->end || c->json[i] != literal[i+1])
             return PARSE_INVALID_VALUE;
 
     c->json += i;
-    v->type = Type;
     return PARSE_OK;
 }
 
+/*
+十进制转 double: 解析时累积前 19 位有效数字 w, 数值为 w * 10^q
+依次尝试整数/Clinger 快速路径、Eisel-Lemire 算法, 有效数字超过 19 位
+且无法判定舍入时用大整数精确比较
+*/
+#define MAX_SIG_DIGITS 19
+#define MAX_BIG_DIGITS 800      /* 之后的数字只影响粘滞位 */
+#define DOUBLE_INF_BITS ((uint64_t)0x7FF << 52)
+#define DOUBLE_FRAC_MASK (((uint64_t)1 << 52) - 1)
+
+static const double exact_pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* 5^q (q = -342..340) 规格化后的 128 位近似值, 每项 {高 64 位, 低 64 位}; 解析用到 308, 输出用到 340 */
+static const uint64_t pow5_128[683 * 2] = {
+    0xEEF453D6923BD65AULL, 0x113FAA2906A13B3FULL, 0x9558B4661B6565F8ULL, 0x4AC7CA59A424C507ULL,
+    0xBAAEE17FA23EBF76ULL, 0x5D79BCF00D2DF649ULL, 0xE95A99DF8ACE6F53ULL, 0xF4D82C2C107973DCULL,
+    0x91D8A02BB6C10594ULL, 0x79071B9B8A4BE869ULL, 0xB64EC836A47146F9ULL, 0x9748E2826CDEE284ULL,
+    0xE3E27A444D8D98B7ULL, 0xFD1B1B2308169B25ULL, 0x8E6D8C6AB0787F72ULL, 0xFE30F0F5E50E20F7ULL,
+    0xB208EF855C969F4FULL, 0xBDBD2D335E51A935ULL, 0xDE8B2B66B3BC4723ULL, 0xAD2C788035E61382ULL,
+    0x8B16FB203055AC76ULL, 0x4C3BCB5021AFCC31ULL, 0xADDCB9E83C6B1793ULL, 0xDF4ABE242A1BBF3DULL,
+    0xD953E8624B85DD78ULL, 0xD71D6DAD34A2AF0DULL, 0x87D4713D6F33AA6BULL, 0x8672648C40E5AD68ULL,
+    0xA9C98D8CCB009506ULL, 0x680EFDAF511F18C2ULL, 0xD43BF0EFFDC0BA48ULL, 0x0212BD1B2566DEF2ULL,
+    0x84A57695FE98746DULL, 0x014BB630F7604B57ULL, 0xA5CED43B7E3E9188ULL, 0x419EA3BD35385E2DULL,
+    0xCF42894A5DCE35EAULL, 0x52064CAC828675B9ULL, 0x818995CE7AA0E1B2ULL, 0x7343EFEBD1940993ULL,
+    0xA1EBFB4219491A1FULL, 0x1014EBE6C5F90BF8ULL, 0xCA66FA129F9B60A6ULL, 0xD41A26E077774EF6ULL,
+    0xFD00B897478238D0ULL, 0x8920B098955522B4ULL, 0x9E20735E8CB16382ULL, 0x55B46E5F5D5535B0ULL,
+    0xC5A890362FDDBC62ULL, 0xEB2189F734AA831DULL, 0xF712B443BBD52B7BULL, 0xA5E9EC7501D523E4ULL,
+    0x9A6BB0AA55653B2DULL, 0x47B233C92125366EULL, 0xC1069CD4EABE89F8ULL, 0x999EC0BB696E840AULL,
+    0xF148440A256E2C76ULL, 0xC00670EA43CA250DULL, 0x96CD2A865764DBCAULL, 0x380406926A5E5728ULL,
+    0xBC807527ED3E12BCULL, 0xC605083704F5ECF2ULL, 0xEBA09271E88D976BULL, 0xF7864A44C633682EULL,
+    0x93445B8731587EA3ULL, 0x7AB3EE6AFBE0211DULL, 0xB8157268FDAE9E4CULL, 0x5960EA05BAD82964ULL,
+    0xE61ACF033D1A45DFULL, 0x6FB92487298E33BDULL, 0x8FD0C16206306BABULL, 0xA5D3B6D479F8E056ULL,
+    0xB3C4F1BA87BC8696ULL, 0x8F48A4899877186CULL, 0xE0B62E2929ABA83CULL, 0x331ACDABFE94DE87ULL,
+    0x8C71DCD9BA0B4925ULL, 0x9FF0C08B7F1D0B14ULL, 0xAF8E5410288E1B6FULL, 0x07ECF0AE5EE44DD9ULL,
+    0xDB71E91432B1A24AULL, 0xC9E82CD9F69D6150ULL, 0x892731AC9FAF056EULL, 0xBE311C083A225CD2ULL,
+    0xAB70FE17C79AC6CAULL, 0x6DBD630A48AAF406ULL, 0xD64D3D9DB981787DULL, 0x092CBBCCDAD5B108ULL,
+    0x85F0468293F0EB4EULL, 0x25BBF56008C58EA5ULL, 0xA76C582338ED2621ULL, 0xAF2AF2B80AF6F24EULL,
+    0xD1476E2C07286FAAULL, 0x1AF5AF660DB4AEE1ULL, 0x82CCA4DB847945CAULL, 0x50D98D9FC890ED4DULL,
+    0xA37FCE126597973CULL, 0xE50FF107BAB528A0ULL, 0xCC5FC196FEFD7D0CULL, 0x1E53ED49A96272C8ULL,
+    0xFF77B1FCBEBCDC4FULL, 0x25E8E89C13BB0F7AULL, 0x9FAACF3DF73609B1ULL, 0x77B191618C54E9ACULL,
+    0xC795830D75038C1DULL, 0xD59DF5B9EF6A2417ULL, 0xF97AE3D0D2446F25ULL, 0x4B0573286B44AD1DULL,
+    0x9BECCE62836AC577ULL, 0x4EE367F9430AEC32ULL, 0xC2E801FB244576D5ULL, 0x229C41F793CDA73FULL,
+    0xF3A20279ED56D48AULL, 0x6B43527578C1110FULL, 0x9845418C345644D6ULL, 0x830A13896B78AAA9ULL,
+    0xBE5691EF416BD60CULL, 0x23CC986BC656D553ULL, 0xEDEC366B11C6CB8FULL, 0x2CBFBE86B7EC8AA8ULL,
+    0x94B3A202EB1C3F39ULL, 0x7BF7D71432F3D6A9ULL, 0xB9E08A83A5E34F07ULL, 0xDAF5CCD93FB0CC53ULL,
+    0xE858AD248F5C22C9ULL, 0xD1B3400F8F9CFF68ULL, 0x91376C36D99995BEULL, 0x23100809B9C21FA1ULL,
+    0xB58547448FFFFB2DULL, 0xABD40A0C2832A78AULL, 0xE2E69915B3FFF9F9ULL, 0x16C90C8F323F516CULL,
+    0x8DD01FAD907FFC3BULL, 0xAE3DA7D97F6792E3ULL, 0xB1442798F49FFB4AULL, 0x99CD11CFDF41779CULL,
+    0xDD95317F31C7FA1DULL, 0x40405643D711D583ULL, 0x8A7D3EEF7F1CFC52ULL, 0x482835EA666B2572ULL,
+    0xAD1C8EAB5EE43B66ULL, 0xDA3243650005EECFULL, 0xD863B256369D4A40ULL, 0x90BED43E40076A82ULL,
+    0x873E4F75E2224E68ULL, 0x5A7744A6E804A291ULL, 0xA90DE3535AAAE202ULL, 0x711515D0A205CB36ULL,
+    0xD3515C2831559A83ULL, 0x0D5A5B44CA873E03ULL, 0x8412D9991ED58091ULL, 0xE858790AFE9486C2ULL,
+    0xA5178FFF668AE0B6ULL, 0x626E974DBE39A872ULL, 0xCE5D73FF402D98E3ULL, 0xFB0A3D212DC8128FULL,
+    0x80FA687F881C7F8EULL, 0x7CE66634BC9D0B99ULL, 0xA139029F6A239F72ULL, 0x1C1FFFC1EBC44E80ULL,
+    0xC987434744AC874EULL, 0xA327FFB266B56220ULL, 0xFBE9141915D7A922ULL, 0x4BF1FF9F0062BAA8ULL,
+    0x9D71AC8FADA6C9B5ULL, 0x6F773FC3603DB4A9ULL, 0xC4CE17B399107C22ULL, 0xCB550FB4384D21D3ULL,
+    0xF6019DA07F549B2BULL, 0x7E2A53A146606A48ULL, 0x99C102844F94E0FBULL, 0x2EDA7444CBFC426DULL,
+    0xC0314325637A1939ULL, 0xFA911155FEFB5308ULL, 0xF03D93EEBC589F88ULL, 0x793555AB7EBA27CAULL,
+    0x96267C7535B763B5ULL, 0x4BC1558B2F3458DEULL, 0xBBB01B9283253CA2ULL, 0x9EB1AAEDFB016F16ULL,
+    0xEA9C227723EE8BCBULL, 0x465E15A979C1CADCULL, 0x92A1958A7675175FULL, 0x0BFACD89EC191EC9ULL,
+    0xB749FAED14125D36ULL, 0xCEF980EC671F667BULL, 0xE51C79A85916F484ULL, 0x82B7E12780E7401AULL,
+    0x8F31CC0937AE58D2ULL, 0xD1B2ECB8B0908810ULL, 0xB2FE3F0B8599EF07ULL, 0x861FA7E6DCB4AA15ULL,
+    0xDFBDCECE67006AC9ULL, 0x67A791E093E1D49AULL, 0x8BD6A141006042BDULL, 0xE0C8BB2C5C6D24E0ULL,
+    0xAECC49914078536DULL, 0x58FAE9F773886E18ULL, 0xDA7F5BF590966848ULL, 0xAF39A475506A899EULL,
+    0x888F99797A5E012DULL, 0x6D8406C952429603ULL, 0xAAB37FD7D8F58178ULL, 0xC8E5087BA6D33B83ULL,
+    0xD5605FCDCF32E1D6ULL, 0xFB1E4A9A90880A64ULL, 0x855C3BE0A17FCD26ULL, 0x5CF2EEA09A55067FULL,
+    0xA6B34AD8C9DFC06FULL, 0xF42FAA48C0EA481EULL, 0xD0601D8EFC57B08BULL, 0xF13B94DAF124DA26ULL,
+    0x823C12795DB6CE57ULL, 0x76C53D08D6B70858ULL, 0xA2CB1717B52481EDULL, 0x54768C4B0C64CA6EULL,
+    0xCB7DDCDDA26DA268ULL, 0xA9942F5DCF7DFD09ULL, 0xFE5D54150B090B02ULL, 0xD3F93B35435D7C4CULL,
+    0x9EFA548D26E5A6E1ULL, 0xC47BC5014A1A6DAFULL, 0xC6B8E9B0709F109AULL, 0x359AB6419CA1091BULL,
+    0xF867241C8CC6D4C0ULL, 0xC30163D203C94B62ULL, 0x9B407691D7FC44F8ULL, 0x79E0DE63425DCF1DULL,
+    0xC21094364DFB5636ULL, 0x985915FC12F542E4ULL, 0xF294B943E17A2BC4ULL, 0x3E6F5B7B17B2939DULL,
+    0x979CF3CA6CEC5B5AULL, 0xA705992CEECF9C42ULL, 0xBD8430BD08277231ULL, 0x50C6FF782A838353ULL,
+    0xECE53CEC4A314EBDULL, 0xA4F8BF5635246428ULL, 0x940F4613AE5ED136ULL, 0x871B7795E136BE99ULL,
+    0xB913179899F68584ULL, 0x28E2557B59846E3FULL, 0xE757DD7EC07426E5ULL, 0x331AEADA2FE589CFULL,
+    0x9096EA6F3848984FULL, 0x3FF0D2C85DEF7621ULL, 0xB4BCA50B065ABE63ULL, 0x0FED077A756B53A9ULL,
+    0xE1EBCE4DC7F16DFBULL, 0xD3E8495912C62894ULL, 0x8D3360F09CF6E4BDULL, 0x64712DD7ABBBD95CULL,
+    0xB080392CC4349DECULL, 0xBD8D794D96AACFB3ULL, 0xDCA04777F541C567ULL, 0xECF0D7A0FC5583A0ULL,
+    0x89E42CAAF9491B60ULL, 0xF41686C49DB57244ULL, 0xAC5D37D5B79B6239ULL, 0x311C2875C522CED5ULL,
+    0xD77485CB25823AC7ULL, 0x7D633293366B828BULL, 0x86A8D39EF77164BCULL, 0xAE5DFF9C02033197ULL,
+    0xA8530886B54DBDEBULL, 0xD9F57F830283FDFCULL, 0xD267CAA862A12D66ULL, 0xD072DF63C324FD7BULL,
+    0x8380DEA93DA4BC60ULL, 0x4247CB9E59F71E6DULL, 0xA46116538D0DEB78ULL, 0x52D9BE85F074E608ULL,
+    0xCD795BE870516656ULL, 0x67902E276C921F8BULL, 0x806BD9714632DFF6ULL, 0x00BA1CD8A3DB53B6ULL,
+    0xA086CFCD97BF97F3ULL, 0x80E8A40ECCD228A4ULL, 0xC8A883C0FDAF7DF0ULL, 0x6122CD128006B2CDULL,
+    0xFAD2A4B13D1B5D6CULL, 0x796B805720085F81ULL, 0x9CC3A6EEC6311A63ULL, 0xCBE3303674053BB0ULL,
+    0xC3F490AA77BD60FCULL, 0xBEDBFC4411068A9CULL, 0xF4F1B4D515ACB93BULL, 0xEE92FB5515482D44ULL,
+    0x991711052D8BF3C5ULL, 0x751BDD152D4D1C4AULL, 0xBF5CD54678EEF0B6ULL, 0xD262D45A78A0635DULL,
+    0xEF340A98172AACE4ULL, 0x86FB897116C87C34ULL, 0x9580869F0E7AAC0EULL, 0xD45D35E6AE3D4DA0ULL,
+    0xBAE0A846D2195712ULL, 0x8974836059CCA109ULL, 0xE998D258869FACD7ULL, 0x2BD1A438703FC94BULL,
+    0x91FF83775423CC06ULL, 0x7B6306A34627DDCFULL, 0xB67F6455292CBF08ULL, 0x1A3BC84C17B1D542ULL,
+    0xE41F3D6A7377EECAULL, 0x20CABA5F1D9E4A93ULL, 0x8E938662882AF53EULL, 0x547EB47B7282EE9CULL,
+    0xB23867FB2A35B28DULL, 0xE99E619A4F23AA43ULL, 0xDEC681F9F4C31F31ULL, 0x6405FA00E2EC94D4ULL,
+    0x8B3C113C38F9F37EULL, 0xDE83BC408DD3DD04ULL, 0xAE0B158B4738705EULL, 0x9624AB50B148D445ULL,
+    0xD98DDAEE19068C76ULL, 0x3BADD624DD9B0957ULL, 0x87F8A8D4CFA417C9ULL, 0xE54CA5D70A80E5D6ULL,
+    0xA9F6D30A038D1DBCULL, 0x5E9FCF4CCD211F4CULL, 0xD47487CC8470652BULL, 0x7647C3200069671FULL,
+    0x84C8D4DFD2C63F3BULL, 0x29ECD9F40041E073ULL, 0xA5FB0A17C777CF09ULL, 0xF468107100525890ULL,
+    0xCF79CC9DB955C2CCULL, 0x7182148D4066EEB4ULL, 0x81AC1FE293D599BFULL, 0xC6F14CD848405530ULL,
+    0xA21727DB38CB002FULL, 0xB8ADA00E5A506A7CULL, 0xCA9CF1D206FDC03BULL, 0xA6D90811F0E4851CULL,
+    0xFD442E4688BD304AULL, 0x908F4A166D1DA663ULL, 0x9E4A9CEC15763E2EULL, 0x9A598E4E043287FEULL,
+    0xC5DD44271AD3CDBAULL, 0x40EFF1E1853F29FDULL, 0xF7549530E188C128ULL, 0xD12BEE59E68EF47CULL,
+    0x9A94DD3E8CF578B9ULL, 0x82BB74F8301958CEULL, 0xC13A148E3032D6E7ULL, 0xE36A52363C1FAF01ULL,
+    0xF18899B1BC3F8CA1ULL, 0xDC44E6C3CB279AC1ULL, 0x96F5600F15A7B7E5ULL, 0x29AB103A5EF8C0B9ULL,
+    0xBCB2B812DB11A5DEULL, 0x7415D448F6B6F0E7ULL, 0xEBDF661791D60F56ULL, 0x111B495B3464AD21ULL,
+    0x936B9FCEBB25C995ULL, 0xCAB10DD900BEEC34ULL, 0xB84687C269EF3BFBULL, 0x3D5D514F40EEA742ULL,
+    0xE65829B3046B0AFAULL, 0x0CB4A5A3112A5112ULL, 0x8FF71A0FE2C2E6DCULL, 0x47F0E785EABA72ABULL,
+    0xB3F4E093DB73A093ULL, 0x59ED216765690F56ULL, 0xE0F218B8D25088B8ULL, 0x306869C13EC3532CULL,
+    0x8C974F7383725573ULL, 0x1E414218C73A13FBULL, 0xAFBD2350644EEACFULL, 0xE5D1929EF90898FAULL,
+    0xDBAC6C247D62A583ULL, 0xDF45F746B74ABF39ULL, 0x894BC396CE5DA772ULL, 0x6B8BBA8C328EB783ULL,
+    0xAB9EB47C81F5114FULL, 0x066EA92F3F326564ULL, 0xD686619BA27255A2ULL, 0xC80A537B0EFEFEBDULL,
+    0x8613FD0145877585ULL, 0xBD06742CE95F5F36ULL, 0xA798FC4196E952E7ULL, 0x2C48113823B73704ULL,
+    0xD17F3B51FCA3A7A0ULL, 0xF75A15862CA504C5ULL, 0x82EF85133DE648C4ULL, 0x9A984D73DBE722FBULL,
+    0xA3AB66580D5FDAF5ULL, 0xC13E60D0D2E0EBBAULL, 0xCC963FEE10B7D1B3ULL, 0x318DF905079926A8ULL,
+    0xFFBBCFE994E5C61FULL, 0xFDF17746497F7052ULL, 0x9FD561F1FD0F9BD3ULL, 0xFEB6EA8BEDEFA633ULL,
+    0xC7CABA6E7C5382C8ULL, 0xFE64A52EE96B8FC0ULL, 0xF9BD690A1B68637BULL, 0x3DFDCE7AA3C673B0ULL,
+    0x9C1661A651213E2DULL, 0x06BEA10CA65C084EULL, 0xC31BFA0FE5698DB8ULL, 0x486E494FCFF30A62ULL,
+    0xF3E2F893DEC3F126ULL, 0x5A89DBA3C3EFCCFAULL, 0x986DDB5C6B3A76B7ULL, 0xF89629465A75E01CULL,
+    0xBE89523386091465ULL, 0xF6BBB397F1135823ULL, 0xEE2BA6C0678B597FULL, 0x746AA07DED582E2CULL,
+    0x94DB483840B717EFULL, 0xA8C2A44EB4571CDCULL, 0xBA121A4650E4DDEBULL, 0x92F34D62616CE413ULL,
+    0xE896A0D7E51E1566ULL, 0x77B020BAF9C81D17ULL, 0x915E2486EF32CD60ULL, 0x0ACE1474DC1D122EULL,
+    0xB5B5ADA8AAFF80B8ULL, 0x0D819992132456BAULL, 0xE3231912D5BF60E6ULL, 0x10E1FFF697ED6C69ULL,
+    0x8DF5EFABC5979C8FULL, 0xCA8D3FFA1EF463C1ULL, 0xB1736B96B6FD83B3ULL, 0xBD308FF8A6B17CB2ULL,
+    0xDDD0467C64BCE4A0ULL, 0xAC7CB3F6D05DDBDEULL, 0x8AA22C0DBEF60EE4ULL, 0x6BCDF07A423AA96BULL,
+    0xAD4AB7112EB3929DULL, 0x86C16C98D2C953C6ULL, 0xD89D64D57A607744ULL, 0xE871C7BF077BA8B7ULL,
+    0x87625F056C7C4A8BULL, 0x11471CD764AD4972ULL, 0xA93AF6C6C79B5D2DULL, 0xD598E40D3DD89BCFULL,
+    0xD389B47879823479ULL, 0x4AFF1D108D4EC2C3ULL, 0x843610CB4BF160CBULL, 0xCEDF722A585139BAULL,
+    0xA54394FE1EEDB8FEULL, 0xC2974EB4EE658828ULL, 0xCE947A3DA6A9273EULL, 0x733D226229FEEA32ULL,
+    0x811CCC668829B887ULL, 0x0806357D5A3F525FULL, 0xA163FF802A3426A8ULL, 0xCA07C2DCB0CF26F7ULL,
+    0xC9BCFF6034C13052ULL, 0xFC89B393DD02F0B5ULL, 0xFC2C3F3841F17C67ULL, 0xBBAC2078D443ACE2ULL,
+    0x9D9BA7832936EDC0ULL, 0xD54B944B84AA4C0DULL, 0xC5029163F384A931ULL, 0x0A9E795E65D4DF11ULL,
+    0xF64335BCF065D37DULL, 0x4D4617B5FF4A16D5ULL, 0x99EA0196163FA42EULL, 0x504BCED1BF8E4E45ULL,
+    0xC06481FB9BCF8D39ULL, 0xE45EC2862F71E1D6ULL, 0xF07DA27A82C37088ULL, 0x5D767327BB4E5A4CULL,
+    0x964E858C91BA2655ULL, 0x3A6A07F8D510F86FULL, 0xBBE226EFB628AFEAULL, 0x890489F70A55368BULL,
+    0xEADAB0ABA3B2DBE5ULL, 0x2B45AC74CCEA842EULL, 0x92C8AE6B464FC96FULL, 0x3B0B8BC90012929DULL,
+    0xB77ADA0617E3BBCBULL, 0x09CE6EBB40173744ULL, 0xE55990879DDCAABDULL, 0xCC420A6A101D0515ULL,
+    0x8F57FA54C2A9EAB6ULL, 0x9FA946824A12232DULL, 0xB32DF8E9F3546564ULL, 0x47939822DC96ABF9ULL,
+    0xDFF9772470297EBDULL, 0x59787E2B93BC56F7ULL, 0x8BFBEA76C619EF36ULL, 0x57EB4EDB3C55B65AULL,
+    0xAEFAE51477A06B03ULL, 0xEDE622920B6B23F1ULL, 0xDAB99E59958885C4ULL, 0xE95FAB368E45ECEDULL,
+    0x88B402F7FD75539BULL, 0x11DBCB0218EBB414ULL, 0xAAE103B5FCD2A881ULL, 0xD652BDC29F26A119ULL,
+    0xD59944A37C0752A2ULL, 0x4BE76D3346F0495FULL, 0x857FCAE62D8493A5ULL, 0x6F70A4400C562DDBULL,
+    0xA6DFBD9FB8E5B88EULL, 0xCB4CCD500F6BB952ULL, 0xD097AD07A71F26B2ULL, 0x7E2000A41346A7A7ULL,
+    0x825ECC24C873782FULL, 0x8ED400668C0C28C8ULL, 0xA2F67F2DFA90563BULL, 0x728900802F0F32FAULL,
+    0xCBB41EF979346BCAULL, 0x4F2B40A03AD2FFB9ULL, 0xFEA126B7D78186BCULL, 0xE2F610C84987BFA8ULL,
+    0x9F24B832E6B0F436ULL, 0x0DD9CA7D2DF4D7C9ULL, 0xC6EDE63FA05D3143ULL, 0x91503D1C79720DBBULL,
+    0xF8A95FCF88747D94ULL, 0x75A44C6397CE912AULL, 0x9B69DBE1B548CE7CULL, 0xC986AFBE3EE11ABAULL,
+    0xC24452DA229B021BULL, 0xFBE85BADCE996168ULL, 0xF2D56790AB41C2A2ULL, 0xFAE27299423FB9C3ULL,
+    0x97C560BA6B0919A5ULL, 0xDCCD879FC967D41AULL, 0xBDB6B8E905CB600FULL, 0x5400E987BBC1C920ULL,
+    0xED246723473E3813ULL, 0x290123E9AAB23B68ULL, 0x9436C0760C86E30BULL, 0xF9A0B6720AAF6521ULL,
+    0xB94470938FA89BCEULL, 0xF808E40E8D5B3E69ULL, 0xE7958CB87392C2C2ULL, 0xB60B1D1230B20E04ULL,
+    0x90BD77F3483BB9B9ULL, 0xB1C6F22B5E6F48C2ULL, 0xB4ECD5F01A4AA828ULL, 0x1E38AEB6360B1AF3ULL,
+    0xE2280B6C20DD5232ULL, 0x25C6DA63C38DE1B0ULL, 0x8D590723948A535FULL, 0x579C487E5A38AD0EULL,
+    0xB0AF48EC79ACE837ULL, 0x2D835A9DF0C6D851ULL, 0xDCDB1B2798182244ULL, 0xF8E431456CF88E65ULL,
+    0x8A08F0F8BF0F156BULL, 0x1B8E9ECB641B58FFULL, 0xAC8B2D36EED2DAC5ULL, 0xE272467E3D222F3FULL,
+    0xD7ADF884AA879177ULL, 0x5B0ED81DCC6ABB0FULL, 0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4E9ULL,
+    0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL, 0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL,
+    0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL, 0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL,
+    0xCDB02555653131B6ULL, 0x3792F412CB06794DULL, 0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL,
+    0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL, 0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL,
+    0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL, 0x9CED737BB6C4183DULL, 0x55464DD69685606BULL,
+    0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL, 0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL,
+    0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL, 0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL,
+    0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL, 0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL,
+    0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL, 0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL,
+    0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL, 0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL,
+    0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL, 0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL,
+    0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL, 0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL,
+    0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL, 0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL,
+    0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL, 0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL,
+    0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL, 0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL,
+    0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL, 0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL,
+    0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL, 0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL,
+    0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL, 0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL,
+    0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL, 0x9E74D1B791E07E48ULL, 0x775EA264CF55347EULL,
+    0xC612062576589DDAULL, 0x95364AFE032A819EULL, 0xF79687AED3EEC551ULL, 0x3A83DDBD83F52205ULL,
+    0x9ABE14CD44753B52ULL, 0xC4926A9672793543ULL, 0xC16D9A0095928A27ULL, 0x75B7053C0F178294ULL,
+    0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6339ULL, 0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E04ULL,
+    0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF585ULL, 0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E6ULL,
+    0x9392EE8E921D5D07ULL, 0x3AFF322E62439FD0ULL, 0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C3ULL,
+    0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B4ULL, 0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A11ULL,
+    0xB424DC35095CD80FULL, 0x538484C19EF38C95ULL, 0xE12E13424BB40E13ULL, 0x2865A5F206B06FBAULL,
+    0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D4ULL, 0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D749ULL,
+    0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1CULL, 0x89705F4136B4A597ULL, 0x31680A88F8953031ULL,
+    0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3EULL, 0xD6BF94D5E57A42BCULL, 0x3D32907604691B4DULL,
+    0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B110ULL, 0xA7C5AC471B478423ULL, 0x0FCF80DC33721D54ULL,
+    0xD1B71758E219652BULL, 0xD3C36113404EA4A9ULL, 0x83126E978D4FDF3BULL, 0x645A1CAC083126EAULL,
+    0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A4ULL, 0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCDULL,
+    0x8000000000000000ULL, 0x0000000000000000ULL, 0xA000000000000000ULL, 0x0000000000000000ULL,
+    0xC800000000000000ULL, 0x0000000000000000ULL, 0xFA00000000000000ULL, 0x0000000000000000ULL,
+    0x9C40000000000000ULL, 0x0000000000000000ULL, 0xC350000000000000ULL, 0x0000000000000000ULL,
+    0xF424000000000000ULL, 0x0000000000000000ULL, 0x9896800000000000ULL, 0x0000000000000000ULL,
+    0xBEBC200000000000ULL, 0x0000000000000000ULL, 0xEE6B280000000000ULL, 0x0000000000000000ULL,
+    0x9502F90000000000ULL, 0x0000000000000000ULL, 0xBA43B74000000000ULL, 0x0000000000000000ULL,
+    0xE8D4A51000000000ULL, 0x0000000000000000ULL, 0x9184E72A00000000ULL, 0x0000000000000000ULL,
+    0xB5E620F480000000ULL, 0x0000000000000000ULL, 0xE35FA931A0000000ULL, 0x0000000000000000ULL,
+    0x8E1BC9BF04000000ULL, 0x0000000000000000ULL, 0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL,
+    0xDE0B6B3A76400000ULL, 0x0000000000000000ULL, 0x8AC7230489E80000ULL, 0x0000000000000000ULL,
+    0xAD78EBC5AC620000ULL, 0x0000000000000000ULL, 0xD8D726B7177A8000ULL, 0x0000000000000000ULL,
+    0x878678326EAC9000ULL, 0x0000000000000000ULL, 0xA968163F0A57B400ULL, 0x0000000000000000ULL,
+    0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL, 0x84595161401484A0ULL, 0x0000000000000000ULL,
+    0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL, 0xCECB8F27F4200F3AULL, 0x0000000000000000ULL,
+    0x813F3978F8940984ULL, 0x4000000000000000ULL, 0xA18F07D736B90BE5ULL, 0x5000000000000000ULL,
+    0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL, 0xFC6F7C4045812296ULL, 0x4D00000000000000ULL,
+    0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL, 0xC5371912364CE305ULL, 0x6C28000000000000ULL,
+    0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL, 0x9A130B963A6C115CULL, 0x3C7F400000000000ULL,
+    0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL, 0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL,
+    0x96769950B50D88F4ULL, 0x1314448000000000ULL, 0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL,
+    0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL, 0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL,
+    0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL, 0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL,
+    0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL, 0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL,
+    0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL, 0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL,
+    0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL, 0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL,
+    0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL, 0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL,
+    0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL, 0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL,
+    0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL, 0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL,
+    0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL, 0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL,
+    0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL, 0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL,
+    0x9F4F2726179A2245ULL, 0x01D762422C946590ULL, 0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL,
+    0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL, 0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL,
+    0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL, 0xF316271C7FC3908AULL, 0x8BEF464E3945EF7AULL,
+    0x97EDD871CFDA3A56ULL, 0x97758BF0E3CBB5ACULL, 0xBDE94E8E43D0C8ECULL, 0x3D52EEED1CBEA317ULL,
+    0xED63A231D4C4FB27ULL, 0x4CA7AAA863EE4BDDULL, 0x945E455F24FB1CF8ULL, 0x8FE8CAA93E74EF6AULL,
+    0xB975D6B6EE39E436ULL, 0xB3E2FD538E122B44ULL, 0xE7D34C64A9C85D44ULL, 0x60DBBCA87196B616ULL,
+    0x90E40FBEEA1D3A4AULL, 0xBC8955E946FE31CDULL, 0xB51D13AEA4A488DDULL, 0x6BABAB6398BDBE41ULL,
+    0xE264589A4DCDAB14ULL, 0xC696963C7EED2DD1ULL, 0x8D7EB76070A08AECULL, 0xFC1E1DE5CF543CA2ULL,
+    0xB0DE65388CC8ADA8ULL, 0x3B25A55F43294BCBULL, 0xDD15FE86AFFAD912ULL, 0x49EF0EB713F39EBEULL,
+    0x8A2DBF142DFCC7ABULL, 0x6E3569326C784337ULL, 0xACB92ED9397BF996ULL, 0x49C2C37F07965404ULL,
+    0xD7E77A8F87DAF7FBULL, 0xDC33745EC97BE906ULL, 0x86F0AC99B4E8DAFDULL, 0x69A028BB3DED71A3ULL,
+    0xA8ACD7C0222311BCULL, 0xC40832EA0D68CE0CULL, 0xD2D80DB02AABD62BULL, 0xF50A3FA490C30190ULL,
+    0x83C7088E1AAB65DBULL, 0x792667C6DA79E0FAULL, 0xA4B8CAB1A1563F52ULL, 0x577001B891185938ULL,
+    0xCDE6FD5E09ABCF26ULL, 0xED4C0226B55E6F86ULL, 0x80B05E5AC60B6178ULL, 0x544F8158315B05B4ULL,
+    0xA0DC75F1778E39D6ULL, 0x696361AE3DB1C721ULL, 0xC913936DD571C84CULL, 0x03BC3A19CD1E38E9ULL,
+    0xFB5878494ACE3A5FULL, 0x04AB48A04065C723ULL, 0x9D174B2DCEC0E47BULL, 0x62EB0D64283F9C76ULL,
+    0xC45D1DF942711D9AULL, 0x3BA5D0BD324F8394ULL, 0xF5746577930D6500ULL, 0xCA8F44EC7EE36479ULL,
+    0x9968BF6ABBE85F20ULL, 0x7E998B13CF4E1ECBULL, 0xBFC2EF456AE276E8ULL, 0x9E3FEDD8C321A67EULL,
+    0xEFB3AB16C59B14A2ULL, 0xC5CFE94EF3EA101EULL, 0x95D04AEE3B80ECE5ULL, 0xBBA1F1D158724A12ULL,
+    0xBB445DA9CA61281FULL, 0x2A8A6E45AE8EDC97ULL, 0xEA1575143CF97226ULL, 0xF52D09D71A3293BDULL,
+    0x924D692CA61BE758ULL, 0x593C2626705F9C56ULL, 0xB6E0C377CFA2E12EULL, 0x6F8B2FB00C77836CULL,
+    0xE498F455C38B997AULL, 0x0B6DFB9C0F956447ULL, 0x8EDF98B59A373FECULL, 0x4724BD4189BD5EACULL,
+    0xB2977EE300C50FE7ULL, 0x58EDEC91EC2CB657ULL, 0xDF3D5E9BC0F653E1ULL, 0x2F2967B66737E3EDULL,
+    0x8B865B215899F46CULL, 0xBD79E0D20082EE74ULL, 0xAE67F1E9AEC07187ULL, 0xECD8590680A3AA11ULL,
+    0xDA01EE641A708DE9ULL, 0xE80E6F4820CC9495ULL, 0x884134FE908658B2ULL, 0x3109058D147FDCDDULL,
+    0xAA51823E34A7EEDEULL, 0xBD4B46F0599FD415ULL, 0xD4E5E2CDC1D1EA96ULL, 0x6C9E18AC7007C91AULL,
+    0x850FADC09923329EULL, 0x03E2CF6BC604DDB0ULL, 0xA6539930BF6BFF45ULL, 0x84DB8346B786151CULL,
+    0xCFE87F7CEF46FF16ULL, 0xE612641865679A63ULL, 0x81F14FAE158C5F6EULL, 0x4FCB7E8F3F60C07EULL,
+    0xA26DA3999AEF7749ULL, 0xE3BE5E330F38F09DULL, 0xCB090C8001AB551CULL, 0x5CADF5BFD3072CC5ULL,
+    0xFDCB4FA002162A63ULL, 0x73D9732FC7C8F7F6ULL, 0x9E9F11C4014DDA7EULL, 0x2867E7FDDCDD9AFAULL,
+    0xC646D63501A1511DULL, 0xB281E1FD541501B8ULL, 0xF7D88BC24209A565ULL, 0x1F225A7CA91A4226ULL,
+    0x9AE757596946075FULL, 0x3375788DE9B06958ULL, 0xC1A12D2FC3978937ULL, 0x0052D6B1641C83AEULL,
+    0xF209787BB47D6B84ULL, 0xC0678C5DBD23A49AULL, 0x9745EB4D50CE6332ULL, 0xF840B7BA963646E0ULL,
+    0xBD176620A501FBFFULL, 0xB650E5A93BC3D898ULL, 0xEC5D3FA8CE427AFFULL, 0xA3E51F138AB4CEBEULL,
+    0x93BA47C980E98CDFULL, 0xC66F336C36B10137ULL, 0xB8A8D9BBE123F017ULL, 0xB80B0047445D4184ULL,
+    0xE6D3102AD96CEC1DULL, 0xA60DC059157491E5ULL, 0x9043EA1AC7E41392ULL, 0x87C89837AD68DB2FULL,
+    0xB454E4A179DD1877ULL, 0x29BABE4598C311FBULL, 0xE16A1DC9D8545E94ULL, 0xF4296DD6FEF3D67AULL,
+    0x8CE2529E2734BB1DULL, 0x1899E4A65F58660CULL, 0xB01AE745B101E9E4ULL, 0x5EC05DCFF72E7F8FULL,
+    0xDC21A1171D42645DULL, 0x76707543F4FA1F73ULL, 0x899504AE72497EBAULL, 0x6A06494A791C53A8ULL,
+    0xABFA45DA0EDBDE69ULL, 0x0487DB9D17636892ULL, 0xD6F8D7509292D603ULL, 0x45A9D2845D3C42B6ULL,
+    0x865B86925B9BC5C2ULL, 0x0B8A2392BA45A9B2ULL, 0xA7F26836F282B732ULL, 0x8E6CAC7768D7141EULL,
+    0xD1EF0244AF2364FFULL, 0x3207D795430CD926ULL, 0x8335616AED761F1FULL, 0x7F44E6BD49E807B8ULL,
+    0xA402B9C5A8D3A6E7ULL, 0x5F16206C9C6209A6ULL, 0xCD036837130890A1ULL, 0x36DBA887C37A8C0FULL,
+    0x802221226BE55A64ULL, 0xC2494954DA2C9789ULL, 0xA02AA96B06DEB0FDULL, 0xF2DB9BAA10B7BD6CULL,
+    0xC83553C5C8965D3DULL, 0x6F92829494E5ACC7ULL, 0xFA42A8B73ABBF48CULL, 0xCB772339BA1F17F9ULL,
+    0x9C69A97284B578D7ULL, 0xFF2A760414536EFBULL, 0xC38413CF25E2D70DULL, 0xFEF5138519684ABAULL,
+    0xF46518C2EF5B8CD1ULL, 0x7EB258665FC25D69ULL, 0x98BF2F79D5993802ULL, 0xEF2F773FFBD97A61ULL,
+    0xBEEEFB584AFF8603ULL, 0xAAFB550FFACFD8FAULL, 0xEEAABA2E5DBF6784ULL, 0x95BA2A53F983CF38ULL,
+    0x952AB45CFA97A0B2ULL, 0xDD945A747BF26183ULL, 0xBA756174393D88DFULL, 0x94F971119AEEF9E4ULL,
+    0xE912B9D1478CEB17ULL, 0x7A37CD5601AAB85DULL, 0x91ABB422CCB812EEULL, 0xAC62E055C10AB33AULL,
+    0xB616A12B7FE617AAULL, 0x577B986B314D6009ULL, 0xE39C49765FDF9D94ULL, 0xED5A7E85FDA0B80BULL,
+    0x8E41ADE9FBEBC27DULL, 0x14588F13BE847307ULL, 0xB1D219647AE6B31CULL, 0x596EB2D8AE258FC8ULL,
+    0xDE469FBD99A05FE3ULL, 0x6FCA5F8ED9AEF3BBULL, 0x8AEC23D680043BEEULL, 0x25DE7BB9480D5854ULL,
+    0xADA72CCC20054AE9ULL, 0xAF561AA79A10AE6AULL, 0xD910F7FF28069DA4ULL, 0x1B2BA1518094DA04ULL,
+    0x87AA9AFF79042286ULL, 0x90FB44D2F05D0842ULL, 0xA99541BF57452B28ULL, 0x353A1607AC744A53ULL,
+    0xD3FA922F2D1675F2ULL, 0x42889B8997915CE8ULL, 0x847C9B5D7C2E09B7ULL, 0x69956135FEBADA11ULL,
+    0xA59BC234DB398C25ULL, 0x43FAB9837E699095ULL, 0xCF02B2C21207EF2EULL, 0x94F967E45E03F4BBULL,
+    0x8161AFB94B44F57DULL, 0x1D1BE0EEBAC278F5ULL, 0xA1BA1BA79E1632DCULL, 0x6462D92A69731732ULL,
+    0xCA28A291859BBF93ULL, 0x7D7B8F7503CFDCFEULL, 0xFCB2CB35E702AF78ULL, 0x5CDA735244C3D43EULL,
+    0x9DEFBF01B061ADABULL, 0x3A0888136AFA64A7ULL, 0xC56BAEC21C7A1916ULL, 0x088AAA1845B8FDD0ULL,
+    0xF6C69A72A3989F5BULL, 0x8AAD549E57273D45ULL, 0x9A3C2087A63F6399ULL, 0x36AC54E2F678864BULL,
+    0xC0CB28A98FCF3C7FULL, 0x84576A1BB416A7DDULL, 0xF0FDF2D3F3C30B9FULL, 0x656D44A2A11C51D5ULL,
+    0x969EB7C47859E743ULL, 0x9F644AE5A4B1B325ULL, 0xBC4665B596706114ULL, 0x873D5D9F0DDE1FEEULL,
+    0xEB57FF22FC0C7959ULL, 0xA90CB506D155A7EAULL, 0x9316FF75DD87CBD8ULL, 0x09A7F12442D588F2ULL,
+    0xB7DCBF5354E9BECEULL, 0x0C11ED6D538AEB2FULL, 0xE5D3EF282A242E81ULL, 0x8F1668C8A86DA5FAULL,
+    0x8FA475791A569D10ULL, 0xF96E017D694487BCULL, 0xB38D92D760EC4455ULL, 0x37C981DCC395A9ACULL,
+    0xE070F78D3927556AULL, 0x85BBE253F47B1417ULL, 0x8C469AB843B89562ULL, 0x93956D7478CCEC8EULL,
+    0xAF58416654A6BABBULL, 0x387AC8D1970027B2ULL, 0xDB2E51BFE9D0696AULL, 0x06997B05FCC0319EULL,
+    0x88FCF317F22241E2ULL, 0x441FECE3BDF81F03ULL, 0xAB3C2FDDEEAAD25AULL, 0xD527E81CAD7626C3ULL,
+    0xD60B3BD56A5586F1ULL, 0x8A71E223D8D3B074ULL, 0x85C7056562757456ULL, 0xF6872D5667844E49ULL,
+    0xA738C6BEBB12D16CULL, 0xB428F8AC016561DBULL, 0xD106F86E69D785C7ULL, 0xE13336D701BEBA52ULL,
+    0x82A45B450226B39CULL, 0xECC0024661173473ULL, 0xA34D721642B06084ULL, 0x27F002D7F95D0190ULL,
+    0xCC20CE9BD35C78A5ULL, 0x31EC038DF7B441F4ULL, 0xFF290242C83396CEULL, 0x7E67047175A15271ULL,
+    0x9F79A169BD203E41ULL, 0x0F0062C6E984D386ULL, 0xC75809C42C684DD1ULL, 0x52C07B78A3E60868ULL,
+    0xF92E0C3537826145ULL, 0xA7709A56CCDF8A82ULL, 0x9BBCC7A142B17CCBULL, 0x88A66076400BB691ULL,
+    0xC2ABF989935DDBFEULL, 0x6ACFF893D00EA435ULL, 0xF356F7EBF83552FEULL, 0x0583F6B8C4124D43ULL,
+    0x98165AF37B2153DEULL, 0xC3727A337A8B704AULL, 0xBE1BF1B059E9A8D6ULL, 0x744F18C0592E4C5CULL,
+    0xEDA2EE1C7064130CULL, 0x1162DEF06F79DF73ULL, 0x9485D4D1C63E8BE7ULL, 0x8ADDCB5645AC2BA8ULL,
+    0xB9A74A0637CE2EE1ULL, 0x6D953E2BD7173692ULL, 0xE8111C87C5C1BA99ULL, 0xC8FA8DB6CCDD0437ULL,
+    0x910AB1D4DB9914A0ULL, 0x1D9C9892400A22A2ULL, 0xB54D5E4A127F59C8ULL, 0x2503BEB6D00CAB4BULL,
+    0xE2A0B5DC971F303AULL, 0x2E44AE64840FD61DULL, 0x8DA471A9DE737E24ULL, 0x5CEAECFED289E5D2ULL,
+    0xB10D8E1456105DADULL, 0x7425A83E872C5F47ULL, 0xDD50F1996B947518ULL, 0xD12F124E28F77719ULL,
+    0x8A5296FFE33CC92FULL, 0x82BD6B70D99AAA6FULL, 0xACE73CBFDC0BFB7BULL, 0x636CC64D1001550BULL,
+    0xD8210BEFD30EFA5AULL, 0x3C47F7E05401AA4EULL, 0x8714A775E3E95C78ULL, 0x65ACFAEC34810A71ULL,
+    0xA8D9D1535CE3B396ULL, 0x7F1839A741A14D0DULL, 0xD31045A8341CA07CULL, 0x1EDE48111209A050ULL,
+    0x83EA2B892091E44DULL, 0x934AED0AAB460432ULL, 0xA4E4B66B68B65D60ULL, 0xF81DA84D5617853FULL,
+    0xCE1DE40642E3F4B9ULL, 0x36251260AB9D668EULL, 0x80D2AE83E9CE78F3ULL, 0xC1D72B7C6B426019ULL,
+    0xA1075A24E4421730ULL, 0xB24CF65B8612F81FULL, 0xC94930AE1D529CFCULL, 0xDEE033F26797B627ULL,
+    0xFB9B7CD9A4A7443CULL, 0x169840EF017DA3B1ULL, 0x9D412E0806E88AA5ULL, 0x8E1F289560EE864EULL,
+    0xC491798A08A2AD4EULL, 0xF1A6F2BAB92A27E2ULL, 0xF5B5D7EC8ACB58A2ULL, 0xAE10AF696774B1DBULL,
+    0x9991A6F3D6BF1765ULL, 0xACCA6DA1E0A8EF29ULL, 0xBFF610B0CC6EDD3FULL, 0x17FD090A58D32AF3ULL,
+    0xEFF394DCFF8A948EULL, 0xDDFC4B4CEF07F5B0ULL, 0x95F83D0A1FB69CD9ULL, 0x4ABDAF101564F98EULL,
+    0xBB764C4CA7A4440FULL, 0x9D6D1AD41ABE37F1ULL, 0xEA53DF5FD18D5513ULL, 0x84C86189216DC5EDULL,
+    0x92746B9BE2F8552CULL, 0x32FD3CF5B4E49BB4ULL, 0xB7118682DBB66A77ULL, 0x3FBC8C33221DC2A1ULL,
+    0xE4D5E82392A40515ULL, 0x0FABAF3FEAA5334AULL, 0x8F05B1163BA6832DULL, 0x29CB4D87F2A7400EULL,
+    0xB2C71D5BCA9023F8ULL, 0x743E20E9EF511012ULL, 0xDF78E4B2BD342CF6ULL, 0x914DA9246B255416ULL,
+    0x8BAB8EEFB6409C1AULL, 0x1AD089B6C2F7548EULL, 0xAE9672ABA3D0C320ULL, 0xA184AC2473B529B1ULL,
+    0xDA3C0F568CC4F3E8ULL, 0xC9E5D72D90A2741EULL, 0x8865899617FB1871ULL, 0x7E2FA67C7A658892ULL,
+    0xAA7EEBFB9DF9DE8DULL, 0xDDBB901B98FEEAB7ULL, 0xD51EA6FA85785631ULL, 0x552A74227F3EA565ULL,
+    0x8533285C936B35DEULL, 0xD53A88958F87275FULL, 0xA67FF273B8460356ULL, 0x8A892ABAF368F137ULL,
+    0xD01FEF10A657842CULL, 0x2D2B7569B0432D85ULL, 0x8213F56A67F6B29BULL, 0x9C3B29620E29FC73ULL,
+    0xA298F2C501F45F42ULL, 0x8349F3BA91B47B8FULL, 0xCB3F2F7642717713ULL, 0x241C70A936219A73ULL,
+    0xFE0EFB53D30DD4D7ULL, 0xED238CD383AA0110ULL, 0x9EC95D1463E8A506ULL, 0xF4363804324A40AAULL,
+    0xC67BB4597CE2CE48ULL, 0xB143C6053EDCD0D5ULL, 0xF81AA16FDC1B81DAULL, 0xDD94B7868E94050AULL,
+    0x9B10A4E5E9913128ULL, 0xCA7CF2B4191C8326ULL, 0xC1D4CE1F63F57D72ULL, 0xFD1C2F611F63A3F0ULL,
+    0xF24A01A73CF2DCCFULL, 0xBC633B39673C8CECULL, 0x976E41088617CA01ULL, 0xD5BE0503E085D813ULL,
+    0xBD49D14AA79DBC82ULL, 0x4B2D8644D8A74E18ULL, 0xEC9C459D51852BA2ULL, 0xDDF8E7D60ED1219EULL,
+    0x93E1AB8252F33B45ULL, 0xCABB90E5C942B503ULL, 0xB8DA1662E7B00A17ULL, 0x3D6A751F3B936243ULL,
+    0xE7109BFBA19C0C9DULL, 0x0CC512670A783AD4ULL, 0x906A617D450187E2ULL, 0x27FB2B80668B24C5ULL,
+    0xB484F9DC9641E9DAULL, 0xB1F9F660802DEDF6ULL, 0xE1A63853BBD26451ULL, 0x5E7873F8A0396973ULL,
+    0x8D07E33455637EB2ULL, 0xDB0B487B6423E1E8ULL, 0xB049DC016ABC5E5FULL, 0x91CE1A9A3D2CDA62ULL,
+    0xDC5C5301C56B75F7ULL, 0x7641A140CC7810FBULL, 0x89B9B3E11B6329BAULL, 0xA9E904C87FCB0A9DULL,
+    0xAC2820D9623BF429ULL, 0x546345FA9FBDCD44ULL, 0xD732290FBACAF133ULL, 0xA97C177947AD4095ULL,
+    0x867F59A9D4BED6C0ULL, 0x49ED8EABCCCC485DULL, 0xA81F301449EE8C70ULL, 0x5C68F256BFFF5A74ULL,
+    0xD226FC195C6A2F8CULL, 0x73832EEC6FFF3111ULL, 0x83585D8FD9C25DB7ULL, 0xC831FD53C5FF7EABULL,
+    0xA42E74F3D032F525ULL, 0xBA3E7CA8B77F5E55ULL, 0xCD3A1230C43FB26FULL, 0x28CE1BD2E55F35EBULL,
+    0x80444B5E7AA7CF85ULL, 0x7980D163CF5B81B3ULL, 0xA0555E361951C366ULL, 0xD7E105BCC332621FULL,
+    0xC86AB5C39FA63440ULL, 0x8DD9472BF3FEFAA7ULL, 0xFA856334878FC150ULL, 0xB14F98F6F0FEB951ULL,
+    0x9C935E00D4B9D8D2ULL, 0x6ED1BF9A569F33D3ULL, 0xC3B8358109E84F07ULL, 0x0A862F80EC4700C8ULL,
+    0xF4A642E14C6262C8ULL, 0xCD27BB612758C0FAULL, 0x98E7E9CCCFBD7DBDULL, 0x8038D51CB897789CULL,
+    0xBF21E44003ACDD2CULL, 0xE0470A63E6BD56C3ULL, 0xEEEA5D5004981478ULL, 0x1858CCFCE06CAC74ULL,
+    0x95527A5202DF0CCBULL, 0x0F37801E0C43EBC8ULL, 0xBAA718E68396CFFDULL, 0xD30560258F54E6BAULL,
+    0xE950DF20247C83FDULL, 0x47C6B82EF32A2069ULL, 0x91D28B7416CDD27EULL, 0x4CDC331D57FA5441ULL,
+    0xB6472E511C81471DULL, 0xE0133FE4ADF8E952ULL, 0xE3D8F9E563A198E5ULL, 0x58180FDDD97723A6ULL,
+    0x8E679C2F5E44FF8FULL, 0x570F09EAA7EA7648ULL, 0xB201833B35D63F73ULL, 0x2CD2CC6551E513DAULL,
+    0xDE81E40A034BCF4FULL, 0xF8077F7EA65E58D1ULL, 0x8B112E86420F6191ULL, 0xFB04AFAF27FAF782ULL,
+    0xADD57A27D29339F6ULL, 0x79C5DB9AF1F9B563ULL, 0xD94AD8B1C7380874ULL, 0x18375281AE7822BCULL,
+    0x87CEC76F1C830548ULL, 0x8F2293910D0B15B5ULL, 0xA9C2794AE3A3C69AULL, 0xB2EB3875504DDB22ULL,
+    0xD433179D9C8CB841ULL, 0x5FA60692A46151EBULL, 0x849FEEC281D7F328ULL, 0xDBC7C41BA6BCD333ULL,
+    0xA5C7EA73224DEFF3ULL, 0x12B9B522906C0800ULL, 0xCF39E50FEAE16BEFULL, 0xD768226B34870A00ULL,
+    0x81842F29F2CCE375ULL, 0xE6A1158300D46640ULL, 0xA1E53AF46F801C53ULL, 0x60495AE3C1097FD0ULL,
+    0xCA5E89B18B602368ULL, 0x385BB19CB14BDFC4ULL, 0xFCF62C1DEE382C42ULL, 0x46729E03DD9ED7B5ULL,
+    0x9E19DB92B4E31BA9ULL, 0x6C07A2C26A8346D1ULL, 0xC5A05277621BE293ULL, 0xC7098B7305241885ULL,
+    0xF70867153AA2DB38ULL, 0xB8CBEE4FC66D1EA7ULL, 0x9A65406D44A5C903ULL, 0x737F74F1DC043328ULL,
+    0xC0FE908895CF3B44ULL, 0x505F522E53053FF2ULL, 0xF13E34AABB430A15ULL, 0x647726B9E7C68FEFULL,
+    0x96C6E0EAB509E64DULL, 0x5ECA783430DC19F5ULL, 0xBC789925624C5FE0ULL, 0xB67D16413D132072ULL,
+    0xEB96BF6EBADF77D8ULL, 0xE41C5BD18C57E88FULL, 0x933E37A534CBAAE7ULL, 0x8E91B962F7B6F159ULL,
+    0xB80DC58E81FE95A1ULL, 0x723627BBB5A4ADB0ULL, 0xE61136F2227E3B09ULL, 0xCEC3B1AAA30DD91CULL,
+    0x8FCAC257558EE4E6ULL, 0x213A4F0AA5E8A7B1ULL, 0xB3BD72ED2AF29E1FULL, 0xA988E2CD4F62D19DULL,
+    0xE0ACCFA875AF45A7ULL, 0x93EB1B80A33B8605ULL, 0x8C6C01C9498D8B88ULL, 0xBC72F130660533C3ULL,
+    0xAF87023B9BF0EE6AULL, 0xEB8FAD7C7F8680B4ULL
+};
+
+static inline uint64_t umul128(uint64_t a, uint64_t b, uint64_t* hi) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 r = (unsigned __int128)a * b;
+    *hi = (uint64_t)(r >> 64);
+    return (uint64_t)r;
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(a, b, hi);
+#else
+    uint64_t a0 = (uint32_t)a, a1 = a >> 32, b0 = (uint32_t)b, b1 = b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+    *hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    return (mid << 32) | (uint32_t)p00;
+#endif
+}
+
+/* 返回 w * 10^q 就近舍入后 double 的位模式(不含符号), w 为精确值时结果总是正确的 */
+static uint64_t eisel_lemire(uint64_t w, int q) {
+    uint64_t lo, hi, hi2, mantissa;
+    int lz, upperbit, shift, power2;
+    if (w == 0 || q < -342)
+        return 0;
+    if (q > 308)
+        return DOUBLE_INF_BITS;
+    lz = CLZ64(w);
+    w <<= lz;
+    lo = umul128(w, pow5_128[2 * (q + 342)], &hi);
+    if ((hi & 0x1FF) == 0x1FF) {    /* 低位可能进位, 乘上 5^q 的低 64 位修正 */
+        umul128(w, pow5_128[2 * (q + 342) + 1], &hi2);
+        lo += hi2;
+        if (hi2 > lo)
+            hi++;
+    }
+    upperbit = (int)(hi >> 63);
+    shift = upperbit + 64 - 52 - 3;
+    mantissa = hi >> shift;
+    power2 = (((152170 + 65536) * q) >> 16) + 63 + upperbit - lz + 1023;    /* floor(log2(10^q)) + ... */
+    if (power2 <= 0) {      /* 非规格化数 */
+        if (-power2 + 1 >= 64)
+            return 0;
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        power2 = mantissa < ((uint64_t)1 << 52) ? 0 : 1;
+        return mantissa | (uint64_t)power2 << 52;
+    }
+    /* 恰好位于两个 double 中间时向偶数舍入 */
+    if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == hi)
+        mantissa &= ~(uint64_t)1;
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= ((uint64_t)2 << 52)) {
+        mantissa = (uint64_t)1 << 52;
+        power2++;
+    }
+    if (power2 >= 0x7FF)
+        return DOUBLE_INF_BITS;
+    return (mantissa & DOUBLE_FRAC_MASK) | (uint64_t)power2 << 52;
+}
+
+#define BIGINT_LIMBS 128
+
+struct bigint
+{
+    uint32_t d[BIGINT_LIMBS];   /* 低位在前 */
+    int n;
+};
+
+static void bigint_mul_small(bigint* b, uint32_t m) {
+    uint64_t carry = 0;
+    for (int i = 0; i < b->n; i++) {
+        uint64_t t = (uint64_t)b->d[i] * m + carry;
+        b->d[i] = (uint32_t)t;
+        carry = t >> 32;
+    }
+    if (carry) {
+        assert(b->n < BIGINT_LIMBS);
+        b->d[b->n++] = (uint32_t)carry;
+    }
+}
+
+static void bigint_add_small(bigint* b, uint32_t a) {
+    for (int i = 0; a && i < b->n; i++) {
+        uint64_t t = (uint64_t)b->d[i] + a;
+        b->d[i] = (uint32_t)t;
+        a = (uint32_t)(t >> 32);
+    }
+    if (a) {
+        assert(b->n < BIGINT_LIMBS);
+        b->d[b->n++] = a;
+    }
+}
+
+static void bigint_mul_pow5(bigint* b, int e) {
+    static const uint32_t pow5[] = { 1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125, 9765625, 48828125, 244140625 };
+    for (; e >= 13; e -= 13)
+        bigint_mul_small(b, 1220703125);    /* 5^13 */
+    if (e)
+        bigint_mul_small(b, pow5[e]);
+}
+
+static void bigint_shl(bigint* b, int s) {
+    int limbs = s / 32, bits = s % 32, i;
+    if (b->n == 0)
+        return;
+    assert(b->n + limbs + 1 <= BIGINT_LIMBS);
+    b->d[b->n] = 0;
+    for (i = b->n; i >= 0; i--) {
+        uint32_t hi = bits ? b->d[i] << bits : b->d[i];
+        uint32_t lo = bits && i > 0 ? b->d[i - 1] >> (32 - bits) : 0;
+        b->d[i + limbs] = hi | lo;
+    }
+    for (i = 0; i < limbs; i++)
+        b->d[i] = 0;
+    b->n += limbs + 1;
+    while (b->n > 0 && b->d[b->n - 1] == 0)
+        b->n--;
+}
+
+static int bigint_cmp(const bigint* a, const bigint* b) {
+    if (a->n != b->n)
+        return a->n < b->n ? -1 : 1;
+    for (int i = a->n - 1; i >= 0; i--)
+        if (a->d[i] != b->d[i])
+            return a->d[i] < b->d[i] ? -1 : 1;
+    return 0;
+}
+
+/* 比较 D * 10^E 与 bits 和其后继之间的中点 (2m + 1) * 2^(e - 1) */
+static int compare_halfway(const bigint* digits, int E, uint64_t bits) {
+    bigint l = *digits, r;
+    uint64_t m = bits & DOUBLE_FRAC_MASK;
+    int e = (int)(bits >> 52), s;
+    if (e) {
+        m |= (uint64_t)1 << 52;
+        e -= 1075;
+    }
+    else
+        e = -1074;
+    m = 2 * m + 1;
+    e -= 1;
+    r.d[0] = (uint32_t)m;
+    r.d[1] = (uint32_t)(m >> 32);
+    r.n = r.d[1] ? 2 : 1;
+    /* 10^E = 5^E * 2^E, 2 的幂合并为移位 */
+    if (E >= 0)
+        bigint_mul_pow5(&l, E);
+    else
+        bigint_mul_pow5(&r, -E);
+    s = E - e;
+    if (s > 0)
+        bigint_shl(&l, s);
+    else
+        bigint_shl(&r, -s);
+    return bigint_cmp(&l, &r);
+}
+
+/* 慢速路径: 重新读取 [p, end) 中的全部有效数字, 从近似值 bits 出发逐 ulp 修正 */
+static uint64_t parse_number_slow(const char* p, const char* end, int exp, uint64_t bits) {
+    static const uint32_t pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+    bigint digits;
+    int E = exp, nd = 0, frac = 0, truncated = 0, c;
+    uint32_t chunk = 0, chunk_len = 0;
+    digits.n = 0;
+    for (; p != end; p++) {
+        if (*p == '.') {
+            frac = 1;
+            continue;
+        }
+        if (nd == 0 && *p == '0') {     /* 前导零 */
+            E -= frac;
+            continue;
+        }
+        if (nd < MAX_BIG_DIGITS) {
+            chunk = chunk * 10 + (*p - '0');
+            if (++chunk_len == 9) {
+                bigint_mul_small(&digits, pow10[9]);
+                bigint_add_small(&digits, chunk);
+                chunk = chunk_len = 0;
+            }
+            nd++;
+            E -= frac;
+        }
+        else {
+            E += !frac;
+            truncated |= *p != '0';
+        }
+    }
+    if (truncated) {    /* 截去的数字非零: 末尾补 1, 保证不会落在中点上 */
+        chunk = chunk * 10 + 1;
+        chunk_len++;
+        E--;
+    }
+    if (chunk_len) {
+        bigint_mul_small(&digits, pow10[chunk_len]);
+        bigint_add_small(&digits, chunk);
+    }
+    if (nd == 0 || nd + E < -330)
+        return 0;
+    if (nd + E > 310)
+        return DOUBLE_INF_BITS;
+    if (bits == DOUBLE_INF_BITS)
+        bits--;
+    for (;;) {
+        c = compare_halfway(&digits, E, bits);
+        if (c > 0) {
+            if (++bits == DOUBLE_INF_BITS)
+                break;
+            continue;
+        }
+        if (c == 0) {   /* 恰在中点, 取偶数 */
+            bits += bits & 1;
+            break;
+        }
+        if (bits == 0)
+            break;
+        c = compare_halfway(&digits, E, bits - 1);
+        if (c < 0) {
+            bits--;
+            continue;
+        }
+        if (c == 0)
+            bits -= bits & 1;
+        break;
+    }
+    return bits;
+}
+
 /*
 解析数字
 */
+#define AT(p) ((p) != end ? *(p) : '\0')
+
+/* 纯整数: w 为前 19 位, q 为截去的位数, ndigits 为总位数, last 为最后一位 */
+static int parse_integer(value* v, uint64_t w, int neg, int q, size_t ndigits, char last) {
+    if (q == 1 && ndigits == 20) {  /* 20 位只可能是 uint64 */
+        if (neg || w > 1844674407370955161ULL || (w == 1844674407370955161ULL && last > '5'))
+            return 0;
+        w = w * 10 + (last - '0');
+    }
+    else if (q != 0)
+        return 0;
+    if (!neg) {
+        v->flags = w <= (uint64_t)INT64_MAX ? FLAG_INT64 : FLAG_UINT64;
+        v->u.u64 = w;
+    }
+    else if (w != 0 && w <= (uint64_t)INT64_MAX + 1) {
+        v->flags = FLAG_INT64;
+        v->u.i64 = w == (uint64_t)INT64_MAX + 1 ? INT64_MIN : -(int64_t)w;
+    }
+    else
+        return 0;
+    v->type = EASYJson_NUMBER;
+    return 1;
+}
+
 static int parse_number(context* c, value* v) {
-    const char* p = c->json;
-    if (*p == '-') p++;
+    const char* p = c->json, *end = c->end, *digits, *digits_end;
+    uint64_t w = 0, bits;
+    int neg, nd = 0, q = 0, exp = 0, truncated = 0, frac = 0;
+    double d;
+    neg = AT(p) == '-';
+    p += neg;
 
-    if (*p == '0') p++;
+    digits = p;
+    if (AT(p) == '0') p++;
     else {
-        if( !ISDIGIT1TO9(*p) ) return PARSE_INVALID_VALUE;
-        for (p++; ISDIGIT(*p); p++);
+        if( !ISDIGIT1TO9(AT(p)) ) return PARSE_INVALID_VALUE;
+        for (; ISDIGIT(AT(p)); p++) {
+            if (nd < MAX_SIG_DIGITS) {
+                w = w * 10 + (*p - '0');
+                nd++;
+            }
+            else {
+                q++;
+                truncated |= *p != '0';
+            }
+        }
     }
     
-    if (*p == '.') {
+    if (AT(p) == '.') {
         p++;
-        if (!ISDIGIT(*p)) return PARSE_INVALID_VALUE;
-        for (p++; ISDIGIT(*p); p++);
+        frac = 1;
+        if (!ISDIGIT(AT(p))) return PARSE_INVALID_VALUE;
+        for (; ISDIGIT(AT(p)); p++) {
+            if (nd < MAX_SIG_DIGITS) {
+                w = w * 10 + (*p - '0');
+                nd += w != 0;   /* 小数点后的前导零不算有效数字 */
+                q--;
+            }
+            else
+                truncated |= *p != '0';
+        }
+    }
+    digits_end = p;
+    if (!frac && AT(p) != 'e' && AT(p) != 'E') {
+        /* 纯整数(-0 除外)直接存为 int64/uint64 */
+        if (parse_integer(v, w, neg, q, digits_end - digits, *(digits_end - 1))) {
+            c->json = p;
+            return PARSE_OK;
+        }
     }
-    if (*p == 'e' || *p == 'E') {
+    if (AT(p) == 'e' || AT(p) == 'E') {
+        int exp_neg = 0;
         p++;
-        if (*p == '+' || *p == '-') p++;
-        if (!ISDIGIT(*p)) return PARSE_INVALID_VALUE;
-        for (p++; ISDIGIT(*p); p++);
-    }
-    errno = 0;
-    v->u.n = strtod(c->json, NULL);
-    if (errno == ERANGE && (v->u.n == HUGE_VAL || v->u.n == -HUGE_VAL))
-        return PARSE_NUMBER_TOO_BIG;
-    
+        if (AT(p) == '+' || AT(p) == '-') exp_neg = *p++ == '-';
+        if (!ISDIGIT(AT(p))) return PARSE_INVALID_VALUE;
+        for (; ISDIGIT(AT(p)); p++)
+            if (exp < 100000)   /* 足以溢出或下溢 */
+                exp = exp * 10 + (*p - '0');
+        exp = exp_neg ? -exp : exp;
+        q += exp;
+    }
+
+    if (!truncated && w <= (uint64_t)1 << 53 && q == 0)
+        d = (double)w;      /* 整数 */
+    else if (!truncated && w <= (uint64_t)1 << 53 && q >= -22 && q <= 22)
+        d = q < 0 ? (double)w / exact_pow10[-q] : (double)w * exact_pow10[q];  /* w 与 10^|q| 都是精确的, 只舍入一次 */
+    else {
+        bits = eisel_lemire(w, q);
+        /* 截断时真值在 [w, w + 1) * 10^q 之间, 两端舍入一致即可 */
+        if (truncated && bits != eisel_lemire(w + 1, q))
+            bits = parse_number_slow(digits, digits_end, exp, bits);
+        if (bits == DOUBLE_INF_BITS)
+            return PARSE_NUMBER_TOO_BIG;
+        memcpy(&d, &bits, sizeof(d));
+    }
+    v->u.n = neg ? -d : d;
     v->type = EASYJson_NUMBER;
+    v->flags = 0;
     c->json = p;
     return PARSE_OK;
 }
@@ -109,8 +1038,10 @@ static int parse_number(context* c, value* v) {
 /*
 解析十六进制
 */
-static const char* parse_hex4(const char* p, unsigned* u) {
+static const char* parse_hex4(const char* p, const char* end, unsigned* u) {
     *u = 0;
+    if (end - p < 4)
+        return nullptr;
     for (int i = 0; i<4; i++) {
         char ch = *p++;
         *u <<= 4;
@@ -123,445 +1054,3484 @@ static const char* parse_hex4(const char* p, unsigned* u) {
 }
 
 /*
-编码utf-8
+编码utf-8, 写入 q 并返回写入后的位置
 */
-static void encode_utf8(context* c, unsigned u) {
+static char* encode_utf8(char* q, unsigned u) {
     if (u <= 0x7F) 
-        PUTC(c, u & 0xFF);
+        *q++ = u & 0xFF;
     else if (u <= 0x7FF) {
-        PUTC(c, 0xC0 | ((u >> 6) & 0xFF));
-        PUTC(c, 0x80 | ( u       & 0x3F));
+        *q++ = 0xC0 | ((u >> 6) & 0xFF);
+        *q++ = 0x80 | ( u       & 0x3F);
     }
     else if (u <= 0xFFFF) {
-        PUTC(c, 0xE0 | ((u >> 12) & 0xFF));
-        PUTC(c, 0x80 | ((u >>  6) & 0x3F));
-        PUTC(c, 0x80 | ( u        & 0x3F));
+        *q++ = 0xE0 | ((u >> 12) & 0xFF);
+        *q++ = 0x80 | ((u >>  6) & 0x3F);
+        *q++ = 0x80 | ( u        & 0x3F);
     }
     else {
         assert(u <= 0x10FFFF);
-        PUTC(c, 0xF0 | ((u >> 18) & 0xFF));
-        PUTC(c, 0x80 | ((u >> 12) & 0x3F));
-        PUTC(c, 0x80 | ((u >>  6) & 0x3F));
-        PUTC(c, 0x80 | ( u        & 0x3F));
+        *q++ = 0xF0 | ((u >> 18) & 0xFF);
+        *q++ = 0x80 | ((u >> 12) & 0x3F);
+        *q++ = 0x80 | ((u >>  6) & 0x3F);
+        *q++ = 0x80 | ( u        & 0x3F);
+    }
+    return q;
+}
+
+/*
+解析转义序列, *pp 指向 '\\' 之后, 解码结果(至多 4 字节)写入 *qq
+*/
+static int parse_escape(const char** pp, const char* end, char** qq) {
+    const char* p = *pp;
+    unsigned u, u2;
+    switch (AT(p)) {
+        case '\"': *(*qq)++ = '\"'; break;
+        case '\\': *(*qq)++ = '\\'; break;
+        case '/':  *(*qq)++ = '/';  break;
+        case 'b':  *(*qq)++ = '\b'; break;
+        case 'f':  *(*qq)++ = '\f'; break;
+        case 'n':  *(*qq)++ = '\n'; break;
+        case 'r':  *(*qq)++ = '\r'; break;
+        case 't':  *(*qq)++ = '\t'; break;
+        case 'u':
+            if (!(p = parse_hex4(p + 1, end, &u)))
+                return PARSE_INVALID_UNICODE_HEX;
+            if (u >= 0xD800 && u <= 0xDBFF) { /* surrogate pair */
+                if (AT(p) != '\\')
+                    return PARSE_INVALID_UNICODE_SURROGATE;
+                if (AT(p + 1) != 'u')
+                    return PARSE_INVALID_UNICODE_SURROGATE;
+                if (!(p = parse_hex4(p + 2, end, &u2)))
+                    return PARSE_INVALID_UNICODE_HEX;
+                if (u2 < 0xDC00 || u2 > 0xDFFF)
+                    return PARSE_INVALID_UNICODE_SURROGATE;
+                u = (((u - 0xD800) << 10) | (u2 - 0xDC00)) + 0x10000;
+            }
+            *qq = encode_utf8(*qq, u);
+            *pp = p;
+            return PARSE_OK;
+        default:
+            return PARSE_INVALID_STRING_ESCAPE;
     }
+    *pp = p + 1;
+    return PARSE_OK;
 }
 
 #define STRING_ERROR(err) do{ c->top = head; return err; }while(0)
 
+/*
+原地解析字符串: 转义就地解码, 结尾写 '\0', *str 指向输入缓冲区
+*/
+static int parse_string_insitu(context* c, char** str, size_t* len) {
+    char *p, *q, *r;
+    int ret;
+    EXPECT(c, '\"');
+    p = q = (char*)c->json;
+    for (;;) {
+        r = (char*)scan_string(p, c->end);
+        if (q != p)     /* 前面有过转义, 整段前移 */
+            memmove(q, p, r - p);
+        q += r - p;
+        p = r;
+        if (p == c->end)
+            return PARSE_MISS_QUOTATION_MARK;
+        switch (*p++)
+        {
+        case '\"':
+            *str = (char*)c->json;
+            *len = q - *str;
+            *q = '\0';
+            c->json = p;
+            return PARSE_OK;
+        case '\\':
+            if ((ret = parse_escape((const char**)&p, c->end, &q)) != PARSE_OK)
+                return ret;
+            break;
+        default:
+            return PARSE_INVALID_STRING_CHAR;
+        }
+    }
+}
+
 /*
 解析字符串
 */
 static int parse_string_raw(context* c, char** str, size_t* len) {
     size_t head = c->top;
-    unsigned u, u2;
-    const char* p;
+    int ret;
+    const char *p, *r;
+    if (c->insitu)
+        return parse_string_insitu(c, str, len);
     EXPECT(c, '\"');
     p = c->json;
+    /* 没有转义的字符串直接指向输入, 不经过栈 */
+    r = scan_string(p, c->end);
+    if (r != c->end && *r == '\"') {
+        *str = (char*)p;
+        *len = r - p;
+        c->json = r + 1;
+        return PARSE_OK;
+    }
     for(;;) {
-        char ch = *p++;
-        switch (ch)
+        if (r != p) {   /* 整段拷贝不含特殊字符的部分 */
+            PUTS(c, p, r - p);
+            p = r;
+        }
+        if (p == c->end)
+            STRING_ERROR(PARSE_MISS_QUOTATION_MARK);
+        switch (*p++)
         {
         case '\"':
             *len = c->top - head;
             *str = (char *)context_pop(c, *len);
             c->json = p;
             return PARSE_OK;
-        case '\\':
-                switch (*p++) {
-                    case '\"': PUTC(c, '\"'); break;
-                    case '\\': PUTC(c, '\\'); break;
-                    case '/':  PUTC(c, '/' ); break;
-                    case 'b':  PUTC(c, '\b'); break;
-                    case 'f':  PUTC(c, '\f'); break;
-                    case 'n':  PUTC(c, '\n'); break;
-                    case 'r':  PUTC(c, '\r'); break;
-                    case 't':  PUTC(c, '\t'); break;
-                    case 'u':
-                        if (!(p = parse_hex4(p, &u))) {
-                            STRING_ERROR(PARSE_INVALID_UNICODE_HEX);
-                        }
-                        if (u >= 0xD800 && u <= 0xDBFF) { /* surrogate pair */
-                            if (*p++ != '\\')
-                                STRING_ERROR(PARSE_INVALID_UNICODE_SURROGATE);
-                            if (*p++ != 'u')
-                                STRING_ERROR(PARSE_INVALID_UNICODE_SURROGATE);
-                            if (!(p = parse_hex4(p, &u2)))
-                                STRING_ERROR(PARSE_INVALID_UNICODE_HEX);
-                            if (u2 < 0xDC00 || u2 > 0xDFFF)
-                                STRING_ERROR(PARSE_INVALID_UNICODE_SURROGATE);
-                            u = (((u - 0xD800) << 10) | (u2 - 0xDC00)) + 0x10000;
-                        }
-                        encode_utf8(c, u);
-                        break;
-                    default:
-                        STRING_ERROR(PARSE_INVALID_STRING_ESCAPE);
-                }
-                break;
-        case '\0':
-            STRING_ERROR(PARSE_MISS_QUOTATION_MARK);
+        case '\\': {
+            char* q = (char*)context_push(c, 4);
+            char* q0 = q;
+            if ((ret = parse_escape(&p, c->end, &q)) != PARSE_OK)
+                STRING_ERROR(ret);
+            c->top -= 4 - (q - q0);
+            break;
+        }
         default:
-            if ((unsigned char)ch < 0x20) { 
-                STRING_ERROR(PARSE_INVALID_STRING_CHAR);
-            }
-            PUTC(c, ch);
+            STRING_ERROR(PARSE_INVALID_STRING_CHAR);
         }
+        r = scan_string(p, c->end);
     }
 }
 
-static int parse_string(context* c, value* v) {
-    int ret;
-    char* s;
-    size_t len;
-    if ((ret = parse_string_raw(c, &s, &len)) == PARSE_OK)
-        set_string(v, s, len);
-    return ret;
+/*
+语法部分以事件处理器 H 为模板参数, 每个词法单元对应一次 H 的回调:
+dom_handler 在 context 栈上建树, sax_handler 转发给用户的 handler.
+回调返回 0 表示中止; 出错时 discard_array/discard_object 丢弃已收到的 size 个元素/成员
+*/
+#define HANDLE(call) ((call) ? PARSE_OK : PARSE_TERMINATED)
+
+/*
+嵌套不用递归: 每进入一层数组/对象就在 context 栈上压入一个 frame,
+处理器为其元素压入的内容都在它之上
+*/
+struct frame
+{
+    size_t prev;    /* 外层帧的偏移 + 1, 0 表示没有外层 */
+    size_t size;    /* 已完成的元素/成员数 */
+    char kind;      /* '[' 或 '{' */
+};
+
+#define FRAME(c, cur) ((frame*)((c)->stack + (cur) - 1))
+
+static void frame_open(context* c, size_t* cur, char kind) {
+    size_t off = c->top;
+    frame* f = (frame*)context_push(c, sizeof(frame));
+    f->prev = *cur;
+    f->size = 0;
+    f->kind = kind;
+    *cur = off + 1;
+}
+
+/* 处理器已把帧之上的元素换成了容器值 (SAX 则为空), 将其下移覆盖帧 */
+static void frame_close(context* c, size_t* cur) {
+    size_t off = *cur - 1;
+    *cur = FRAME(c, *cur)->prev;
+    memmove(c->stack + off, c->stack + off + sizeof(frame), c->top - off - sizeof(frame));
+    c->top -= sizeof(frame);
+}
+
+template <typename H>
+static int frame_end(context* c, H& h, size_t* cur) {
+    frame f = *FRAME(c, *cur);
+    if (!(f.kind == '[' ? h.end_array(f.size) : h.end_object(f.size)))
+        return PARSE_TERMINATED;
+    frame_close(c, cur);
+    return PARSE_OK;
 }
 
-static int parse_value(context* c, value* v);/*前向声明*/
+/* 出错时由内向外丢弃各层已收到的元素; keyed 表示最内层对象已压入一个还没有值的键 */
+template <typename H>
+static void frame_discard(context* c, H& h, size_t* cur, int keyed) {
+    while (*cur) {
+        frame f = *FRAME(c, *cur);
+        if (f.kind == '[')
+            h.discard_array(f.size);
+        else
+            h.discard_object(f.size, keyed);
+        context_pop(c, sizeof(frame));
+        *cur = f.prev;
+        keyed = 1;  /* 外层对象的键已压栈, 值就是正在构建的内层容器 */
+    }
+}
 
-static int parse_array(context* c, value* v) {
-    size_t i, size = 0;
+/* 键 ws ':' ws */
+template <typename H>
+static int parse_member_key(context* c, H& h, int* keyed) {
+    char* k;
+    size_t klen;
     int ret;
-    EXPECT(c, '[');
+    if (PEEK(c) != '"')
+        return PARSE_MISS_KEY;
+    if ((ret = parse_string_raw(c, &k, &klen)) != PARSE_OK)
+        return ret;
+    if (!h.key(k, klen))
+        return PARSE_TERMINATED;
+    *keyed = 1;
     parse_whitespace(c);
+    if (PEEK(c) != ':')
+        return PARSE_MISS_COLON;
+    c->json++;
+    parse_whitespace(c);
+    return PARSE_OK;
+}
 
-    if (*c->json == ']') {
-        c->json++;
-        v->type = EASYJson_ARRAY;
-        v->u.a.size = 0;
-        v->u.a.e = nullptr;
-        return PARSE_OK;
-    }
-    for(;;) {
-        value e;
-        init(&e);
-        if ((ret = parse_value(c ,&e)) != PARSE_OK)
+/* depth 为外层已打开的数组/对象层数, 计入 PARSE_MAX_DEPTH */
+template <typename H>
+static int parse_value(context* c, H& h, size_t depth = 0) {
+    size_t cur = 0, len;
+    int ret, keyed = 0, opened;
+    char* s;
+    value n;
+    for (;;) {
+        /* 解析一个值; 非空的数组/对象压入帧后回到循环开头解析其第一个元素 */
+        opened = 0;
+        if (c->json == c->end)
+            ret = PARSE_EXPECT_VALUE;
+        else switch (*c->json)
+        {
+        case 'n':
+            if ((ret = parse_literal(c, "null")) == PARSE_OK)
+                ret = HANDLE(h.null());
             break;
-        memcpy(context_push(c, sizeof(value)), &e, sizeof(value));
-        size++;
-
-        parse_whitespace(c);
-        if (*c->json == ',') {
-            c->json ++;
+        case 't':
+            if ((ret = parse_literal(c, "true")) == PARSE_OK)
+                ret = HANDLE(h.boolean(1));
+            break;
+        case 'f':
+            if ((ret = parse_literal(c, "false")) == PARSE_OK)
+                ret = HANDLE(h.boolean(0));
+            break;
+        default:
+            if ((ret = parse_number(c, &n)) == PARSE_OK)
+                ret = HANDLE(h.number(&n));
+            break;
+        case '"':
+            if ((ret = parse_string_raw(c, &s, &len)) == PARSE_OK)
+                ret = HANDLE(h.string(s, len));
+            break;
+        case '[':
+        case '{': {
+            char kind = *c->json++;
+            if (depth == PARSE_MAX_DEPTH) {
+                ret = PARSE_TOO_DEEP;
+                break;
+            }
+            if (!(kind == '[' ? h.start_array() : h.start_object())) {
+                ret = PARSE_TERMINATED;
+                break;
+            }
+            frame_open(c, &cur, kind);
+            depth++;
+            keyed = 0;
             parse_whitespace(c);
+            if (PEEK(c) == (kind == '[' ? ']' : '}')) {
+                c->json++;
+                if ((ret = frame_end(c, h, &cur)) == PARSE_OK)
+                    depth--;
+            }
+            else {
+                ret = kind == '[' ? PARSE_OK : parse_member_key(c, h, &keyed);
+                opened = 1;
+            }
+            break;
         }
-        else if (*c->json == ']') {
-            c->json++;
-            v->type = EASYJson_ARRAY;
-            v->u.a.size = size;
-            size *= sizeof(value);
-            memcpy(v->u.a.e = (value*)malloc(size), context_pop(c, size), size);
-            return PARSE_OK;
         }
-        else {
-            ret = PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+        if (ret != PARSE_OK)
             break;
+        if (opened)
+            continue;
+
+        /* 一个值已完成: 处理其后的 ',' 或结尾括号, 可能连续结束多层 */
+        for (;;) {
+            frame* f;
+            if (!cur)
+                return PARSE_OK;
+            f = FRAME(c, cur);
+            f->size++;
+            keyed = 0;
+            parse_whitespace(c);
+            if (PEEK(c) == ',') {
+                c->json++;
+                parse_whitespace(c);
+                if (f->kind == '{')
+                    ret = parse_member_key(c, h, &keyed);
+                break;
+            }
+            if (PEEK(c) != (f->kind == '[' ? ']' : '}')) {
+                ret = f->kind == '[' ? PARSE_MISS_COMMA_OR_SQUARE_BRACKET : PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+                break;
+            }
+            c->json++;
+            if ((ret = frame_end(c, h, &cur)) != PARSE_OK)
+                break;
+            depth--;
         }
+        if (ret != PARSE_OK)
+            break;
     }
-    for (int i = 0; i < size; i++)
-        Free((value*)context_pop(c, sizeof(value)));
+    frame_discard(c, h, &cur, keyed);
     return ret;
 }
 
-static int parse_object(context* c, value* v) {
-    size_t i, size;
-    member m;
-    int ret;
-    EXPECT(c, '{');
-    parse_whitespace(c);
-    if (*c->json == '}') {
-        c->json++;
+/*
+建树: 每个值压入 context 栈, 对象的键先压入 member 的前半部分 (k, klen),
+其后的值正好补全该 member; 数组/对象结束时把栈顶 size 个元素移入新分配的块
+*/
+static_assert(offsetof(member, v) + sizeof(value) == sizeof(member), "member must end with its value");
+
+static inline size_t hash_key(const char* key, size_t klen) {
+    uint64_t h = 14695981039346656037ULL;   /* FNV-1a */
+    for (size_t i = 0; i < klen; i++)
+        h = (h ^ (unsigned char)key[i]) * 1099511628211ULL;
+    return (size_t)(h ^ (h >> 32));
+}
+
+/*
+键池: 开放寻址哈希表, 键的副本分配在池自己的 arena 中, 随池一起释放
+*/
+struct key_entry
+{
+    const char* k;
+    size_t len;
+    size_t hash;
+};
+
+struct key_pool
+{
+    arena a;
+    key_entry* slots;
+    size_t mask, count;
+};
+
+key_pool* key_pool_create() {
+    key_pool* kp = (key_pool*)malloc(sizeof(key_pool));
+    arena_init(&kp->a, nullptr, 0);
+    kp->mask = KEY_POOL_INIT_SIZE - 1;
+    kp->slots = (key_entry*)calloc(KEY_POOL_INIT_SIZE, sizeof(key_entry));
+    kp->count = 0;
+    return kp;
+}
+
+void key_pool_destroy(key_pool* kp) {
+    if (!kp)
+        return;
+    arena_release(&kp->a);
+    free(kp->slots);
+    free(kp);
+}
+
+size_t key_pool_size(const key_pool* kp) {
+    assert(kp != nullptr);
+    return kp->count;
+}
+
+static void key_pool_grow(key_pool* kp) {
+    size_t i, j, mask = kp->mask * 2 + 1;
+    key_entry* slots = (key_entry*)calloc(mask + 1, sizeof(key_entry));
+    for (i = 0; i <= kp->mask; i++) {
+        if (!kp->slots[i].k)
+            continue;
+        for (j = kp->slots[i].hash & mask; slots[j].k; j = (j + 1) & mask)
+            ;
+        slots[j] = kp->slots[i];
+    }
+    free(kp->slots);
+    kp->slots = slots;
+    kp->mask = mask;
+}
+
+const char* key_pool_intern(key_pool* kp, const char* k, size_t len) {
+    size_t h, i;
+    char* p;
+    assert(kp != nullptr && (k != nullptr || len == 0));
+    h = hash_key(k, len);
+    for (i = h & kp->mask; kp->slots[i].k; i = (i + 1) & kp->mask)
+        if (kp->slots[i].hash == h && kp->slots[i].len == len && memcmp(kp->slots[i].k, k, len) == 0)
+            return kp->slots[i].k;
+    if ((kp->count + 1) * 2 > kp->mask + 1) {   /* 装载因子不超过 1/2 */
+        key_pool_grow(kp);
+        for (i = h & kp->mask; kp->slots[i].k; i = (i + 1) & kp->mask)
+            ;
+    }
+    memcpy(p = (char*)arena_alloc(&kp->a, len + 1), k, len);
+    p[len] = '\0';
+    kp->slots[i].k = p;
+    kp->slots[i].len = len;
+    kp->slots[i].hash = h;
+    kp->count++;
+    return p;
+}
+
+/* 短字符串 */
+#define INLINE_STRING_MAX (sizeof(((value*)0)->u.ss) - 2)
+static_assert(sizeof(((value*)0)->u.ss) <= sizeof(((value*)0)->u.o), "inline strings must not grow value");
+
+static void set_inline_string(value* v, const char* s, size_t len) {
+    assert(len <= INLINE_STRING_MAX);
+    memcpy(v->u.ss, s, len);
+    v->u.ss[len] = '\0';
+    v->u.ss[sizeof(v->u.ss) - 1] = (char)len;
+    v->type = EASYJson_STRING;
+    v->flags = FLAG_INLINE;
+}
+
+struct dom_handler
+{
+    context* c;
+
+    value* push() {
+        return (value*)context_push(c, sizeof(value));
+    }
+    /* 字符串/键在 context 栈上时, 须在下一次压栈前复制出去 */
+    char* copy(const char* s, size_t len) {
+        char* p;
+        if (c->insitu)
+            return (char*)s;
+        memcpy(p = (char*)context_alloc(c, len + 1), s, len);
+        p[len] = '\0';
+        return p;
+    }
+    int null() {
+        value* v = push();
+        init(v);
+        return 1;
+    }
+    int boolean(int b) {
+        value* v = push();
+        v->type = b ? EASYJson_TRUE : EASYJson_FALSE;
+        v->flags = 0;
+        return 1;
+    }
+    int number(const value* n) {
+        memcpy(push(), n, sizeof(value));
+        return 1;
+    }
+    int string(const char* s, size_t len) {
+        char* p;
+        value* v;
+        if (len <= INLINE_STRING_MAX && !c->insitu) {
+            value t;    /* s 可能在栈上, 先复制出来再压栈 */
+            set_inline_string(&t, s, len);
+            memcpy(push(), &t, sizeof(value));
+            return 1;
+        }
+        p = copy(s, len);
+        v = push();
+        v->type = EASYJson_STRING;
+        v->flags = c->a || c->insitu ? FLAG_BORROWED : 0;
+        v->u.s.s = p;
+        v->u.s.len = len;
+        return 1;
+    }
+    int start_array() { return 1; }
+    int end_array(size_t size) {
+        value* e = nullptr;
+        value* v;
+        if (size) {
+            size_t s = size * sizeof(value);
+            memcpy(e = (value*)context_alloc(c, s), context_pop(c, s), s);
+        }
+        v = push();
+        v->type = EASYJson_ARRAY;
+        v->flags = c->a ? FLAG_BORROWED : 0;
+        v->u.a.e = e;
+        v->u.a.size = v->u.a.capacity = size;
+        return 1;
+    }
+    int start_object() { return 1; }
+    int key(const char* s, size_t len) {
+        char* k = c->keys ? (char*)key_pool_intern(c->keys, s, len) : copy(s, len);
+        member* m = (member*)context_push(c, offsetof(member, v));
+        m->k = k;
+        m->klen = len;
+        return 1;
+    }
+    int end_object(size_t size) {
+        member* m = nullptr;
+        value* v;
+        if (size) {
+            size_t s = size * sizeof(member);
+            memcpy(m = (member*)context_alloc(c, s), context_pop(c, s), s);
+        }
+        v = push();
         v->type = EASYJson_OBJECT;
-        v->u.o.m = nullptr;
-        v->u.o.size = 0;
+        v->flags = (c->a ? FLAG_BORROWED : 0) | (c->a || c->insitu || c->keys ? FLAG_KEYS_BORROWED : 0);
+        v->u.o.m = m;
+        v->u.o.size = v->u.o.capacity = (uint32_t)size;
+        v->u.o.index = nullptr;
+        return 1;
+    }
+    void discard_array(size_t size) {
+        while (size--)
+            Free((value*)context_pop(c, sizeof(value)));
+    }
+    void discard_object(size_t size, int keyed) {
+        if (keyed)
+            context_free_key(c, ((member*)context_pop(c, offsetof(member, v)))->k);
+        while (size--) {
+            member* m = (member*)context_pop(c, sizeof(member));
+            context_free_key(c, m->k);
+            Free(&m->v);
+        }
+    }
+};
+
+/* 把事件转发给用户回调, 未设置的回调忽略 */
+struct sax_handler
+{
+    const handler* h;
+    void* user;
+
+    int null() { return !h->null || h->null(user); }
+    int boolean(int b) { return !h->boolean || h->boolean(user, b); }
+    int number(const value* n) {
+        if ((n->flags & FLAG_INT64) && h->int64)
+            return h->int64(user, n->u.i64);
+        if ((n->flags & FLAG_UINT64) && h->uint64)
+            return h->uint64(user, n->u.u64);
+        return !h->number || h->number(user, get_number(n));
+    }
+    int string(const char* s, size_t len) { return !h->string || h->string(user, s, len); }
+    int start_array() { return !h->start_array || h->start_array(user); }
+    int end_array(size_t size) { return !h->end_array || h->end_array(user, size); }
+    int start_object() { return !h->start_object || h->start_object(user); }
+    int key(const char* s, size_t len) { return !h->key || h->key(user, s, len); }
+    int end_object(size_t size) { return !h->end_object || h->end_object(user, size); }
+    void discard_array(size_t) {}
+    void discard_object(size_t, int) {}
+};
+
+/* 解析结束后 context 栈交还给 p 保留, 没有 p 或超过 p->keep 时释放 */
+static void context_return(context* c, parser* p) {
+    if (p && !(p->keep && c->size > p->keep)) {
+        p->stack = c->stack;
+        p->size = c->size;
+        return;
+    }
+    free(c->stack);
+    if (p) {
+        p->stack = nullptr;
+        p->size = 0;
+    }
+}
+
+static int parse_root(context* c, value* v, parser* p) {
+    dom_handler h = { c };
+    int ret;
+    init(v);
+    parse_whitespace(c);
+
+    if ((ret = parse_value(c, h)) == PARSE_OK) {
+        memcpy(v, context_pop(c, sizeof(value)), sizeof(value));
+        parse_whitespace(c);
+        if (c->json != c->end) {
+            Free(v);
+            ret = PARSE_ROOT_NOT_SINGULAR;
+        }
+    }
+    assert(c->top == 0);
+    context_return(c, p);
+    return ret;
+}
+
+static void context_init(context* c, const char* json, size_t len) {
+    c->json = json;
+    c->end = json + len;
+    c->stack = NULL;
+    c->size = c->top = 0;
+    c->a = nullptr;
+    c->insitu = 0;
+    c->keys = nullptr;
+    c->sink = nullptr;
+}
+
+int parse(EasyJson::value* v, const char* json) {
+    assert(json != nullptr);
+    return parse(v, json, strlen(json));
+}
+
+int parse(value* v, const char* json, size_t len) {
+    context c;
+    assert(v != NULL && (json != nullptr || len == 0));
+    context_init(&c, json, len);
+    return parse_root(&c, v, nullptr);
+}
+
+int parse_arena(value* v, const char* json, arena* a) {
+    context c;
+    assert(v != NULL && json != nullptr && a != nullptr);
+    context_init(&c, json, strlen(json));
+    c.a = a;
+    return parse_root(&c, v, nullptr);
+}
+
+int parse_insitu(value* v, char* json) {
+    context c;
+    assert(v != NULL && json != nullptr);
+    context_init(&c, json, strlen(json));
+    c.insitu = 1;
+    return parse_root(&c, v, nullptr);
+}
+
+void parser_init(parser* p, size_t keep) {
+    assert(p != nullptr);
+    p->stack = nullptr;
+    p->size = 0;
+    p->keep = keep;
+    p->keys = nullptr;
+}
+
+void parser_release(parser* p) {
+    assert(p != nullptr);
+    free(p->stack);
+    p->stack = nullptr;
+    p->size = 0;
+}
+
+int parse(parser* p, value* v, const char* json, size_t len) {
+    context c;
+    assert(p != nullptr && v != NULL && (json != nullptr || len == 0));
+    context_init(&c, json, len);
+    c.stack = p->stack;
+    c.size = p->size;
+    c.keys = p->keys;
+    return parse_root(&c, v, p);
+}
+
+int parse_arena(parser* p, value* v, const char* json, size_t len, arena* a) {
+    context c;
+    assert(p != nullptr && v != NULL && (json != nullptr || len == 0) && a != nullptr);
+    context_init(&c, json, len);
+    c.stack = p->stack;
+    c.size = p->size;
+    c.keys = p->keys;
+    c.a = a;
+    return parse_root(&c, v, p);
+}
+
+int parse_sax(const char* json, const handler* h, void* user) {
+    assert(json != nullptr);
+    return parse_sax(json, strlen(json), h, user);
+}
+
+int parse_sax(const char* json, size_t len, const handler* h, void* user) {
+    context c;
+    sax_handler s = { h, user };
+    int ret;
+    assert(h != nullptr && (json != nullptr || len == 0));
+    context_init(&c, json, len);
+    parse_whitespace(&c);
+    if ((ret = parse_value(&c, s)) == PARSE_OK) {
+        parse_whitespace(&c);
+        if (c.json != c.end)
+            ret = PARSE_ROOT_NOT_SINGULAR;
+    }
+    assert(c.top == 0);
+    free(c.stack);
+    return ret;
+}
+
+/*
+reader 的每个操作在临时 context 上进行, 栈在两次操作之间保留在 reader 中
+*/
+static void reader_load(reader* r, context* c) {
+    context_init(c, r->json, r->end - r->json);
+    c->stack = r->stack;
+    c->size = r->size;
+    parse_whitespace(c);
+}
+
+static void reader_store(reader* r, context* c) {
+    r->json = c->json;
+    r->stack = c->stack;
+    r->size = c->size;
+}
+
+void reader_init(reader* r, const char* json, size_t len) {
+    assert(r != nullptr && (json != nullptr || len == 0));
+    r->json = json;
+    r->end = json + len;
+    r->stack = nullptr;
+    r->size = 0;
+    r->depth = 0;
+    r->field = nullptr;
+}
+
+void reader_release(reader* r) {
+    assert(r != nullptr);
+    free(r->stack);
+    r->stack = nullptr;
+    r->size = 0;
+}
+
+char reader_peek(reader* r) {
+    context c;
+    reader_load(r, &c);
+    r->json = c.json;
+    return PEEK(&c);
+}
+
+int reader_literal(reader* r, const char* literal) {
+    context c;
+    int ret;
+    reader_load(r, &c);
+    if (PEEK(&c) != literal[0])
+        return PARSE_INVALID_VALUE;
+    ret = parse_literal(&c, literal);
+    reader_store(r, &c);
+    return ret;
+}
+
+int reader_number(reader* r, value* n) {
+    context c;
+    int ret;
+    reader_load(r, &c);
+    ret = parse_number(&c, n);
+    reader_store(r, &c);
+    return ret;
+}
+
+int reader_string(reader* r, const char** s, size_t* len) {
+    context c;
+    char* str;
+    int ret;
+    reader_load(r, &c);
+    if (PEEK(&c) != '"')
+        return PARSE_MISS_QUOTATION_MARK;
+    if ((ret = parse_string_raw(&c, &str, len)) == PARSE_OK)
+        *s = str;
+    reader_store(r, &c);
+    return ret;
+}
+
+int reader_open(reader* r, char open) {
+    if (reader_peek(r) != open)
+        return reader_mismatch(r);
+    if (r->depth == PARSE_MAX_DEPTH)
+        return PARSE_TOO_DEEP;
+    r->json++;
+    r->depth++;
+    return PARSE_OK;
+}
+
+int reader_close(reader* r, char close, int* closed) {
+    char ch = reader_peek(r);
+    if (ch == ',' || ch == close) {
+        r->json++;
+        if ((*closed = ch == close))
+            r->depth--;
         return PARSE_OK;
     }
+    return close == ']' ? PARSE_MISS_COMMA_OR_SQUARE_BRACKET : PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+}
+
+int reader_end(reader* r) {
+    reader_peek(r);
+    return r->json == r->end ? PARSE_OK : PARSE_ROOT_NOT_SINGULAR;
+}
+
+int reader_skip(reader* r) {
+    static const handler none = {};
+    sax_handler h = { &none, nullptr };
+    context c;
+    int ret;
+    reader_load(r, &c);
+    ret = parse_value(&c, h, r->depth);
+    c.top = 0;
+    reader_store(r, &c);
+    return ret;
+}
+
+int reader_mismatch(reader* r) {
+    int ret = reader_skip(r);
+    return ret == PARSE_OK ? PARSE_TYPE_MISMATCH : ret;
+}
+
+/*
+增量解析: 嵌套帧 frame 与 dom_handler 压入的值交错存放在 context 栈上,
+state 记录下一个期待的词法单元. 跨块的字符串/数字/字面量先积累到 carry, 完整后再解析
+*/
+enum stream_state {
+    STREAM_VALUE,           /* 期待值 */
+    STREAM_VALUE_OR_CLOSE,  /* '[' 之后 */
+    STREAM_KEY,             /* 对象中 ',' 之后 */
+    STREAM_KEY_OR_CLOSE,    /* '{' 之后 */
+    STREAM_COLON,
+    STREAM_COMMA_OR_CLOSE,
+    STREAM_DONE             /* 根值已完成, 只允许空白 */
+};
+
+struct stream_parser
+{
+    context c;
+    size_t frame;   /* 当前帧在栈中的偏移 + 1 */
+    size_t depth;
+    int state;
+    int error;      /* 出错后 feed 不再解析, 直到 finish */
+    char* carry;    /* 未完整的词法单元 */
+    size_t carry_len, carry_cap;
+    char carry_kind;    /* 0 无, '"' 字符串, 'v' 数字或字面量 */
+    char escape;        /* carry 中的字符串以未配对的 '\\' 结尾 */
+};
+
+#define ISTOKENCHAR(ch) (ISDIGIT(ch) || ((ch) >= 'a' && (ch) <= 'z') || (ch) == '-' || (ch) == '+' || (ch) == '.' || (ch) == 'E')
+
+static void stream_value_done(stream_parser* sp) {
+    if (sp->frame) {
+        FRAME(&sp->c, sp->frame)->size++;
+        sp->state = STREAM_COMMA_OR_CLOSE;
+    }
+    else
+        sp->state = STREAM_DONE;
+}
+
+static int stream_open(stream_parser* sp, char kind) {
+    if (sp->depth == PARSE_MAX_DEPTH)
+        return PARSE_TOO_DEEP;
+    frame_open(&sp->c, &sp->frame, kind);
+    sp->depth++;
+    sp->state = kind == '[' ? STREAM_VALUE_OR_CLOSE : STREAM_KEY_OR_CLOSE;
+    return PARSE_OK;
+}
+
+static void stream_close(stream_parser* sp) {
+    dom_handler h = { &sp->c };
+    frame_end(&sp->c, h, &sp->frame);
+    sp->depth--;
+    stream_value_done(sp);
+}
+
+/* 出错时释放栈上已建好的部分 */
+static void stream_discard(stream_parser* sp) {
+    dom_handler h = { &sp->c };
+    frame_discard(&sp->c, h, &sp->frame, sp->state == STREAM_COLON || sp->state == STREAM_VALUE);
+    if (sp->state == STREAM_DONE && sp->c.top)
+        Free((value*)context_pop(&sp->c, sizeof(value)));
+    assert(sp->c.top == 0);
+}
+
+static void stream_append(stream_parser* sp, const char* p, size_t len) {
+    if (sp->carry_len + len > sp->carry_cap) {
+        while (sp->carry_len + len > sp->carry_cap)
+            sp->carry_cap = sp->carry_cap ? sp->carry_cap + (sp->carry_cap >> 1) : 64;
+        sp->carry = (char*)realloc(sp->carry, sp->carry_cap);
+    }
+    memcpy(sp->carry + sp->carry_len, p, len);
+    sp->carry_len += len;
+}
+
+/* 返回字符串结尾引号 (或控制字符) 之后的位置, 未结束时返回 nullptr; p 在开头引号之后 */
+static const char* string_end(const char* p, const char* end) {
+    for (;;) {
+        p = scan_string(p, end);
+        if (p == end)
+            return nullptr;
+        if (*p++ != '\\')
+            return p;   /* 控制字符留给 parse_string_raw 报错 */
+        if (p++ == end)
+            return nullptr;
+    }
+}
+
+/* 把字符串的后续部分追加到 carry, 返回值同 string_end */
+static const char* stream_carry_string(stream_parser* sp, const char* p, const char* end) {
+    const char* q = p;
+    if (sp->escape && q != end) {
+        q++;
+        sp->escape = 0;
+    }
+    for (;;) {
+        q = scan_string(q, end);
+        if (q == end)
+            break;
+        if (*q++ != '\\') {
+            stream_append(sp, p, q - p);
+            return q;
+        }
+        if (q == end) {
+            sp->escape = 1;
+            break;
+        }
+        q++;
+    }
+    stream_append(sp, p, end - p);
+    return nullptr;
+}
+
+/* 解析 [p, end); last 为 0 时结尾处不完整的词法单元存入 carry */
+static int stream_run(stream_parser* sp, const char* p, const char* end, int last) {
+    context* c = &sp->c;
+    dom_handler h = { c };
+    const char* q;
+    char* k;
+    size_t klen;
+    value n;
+    int ret;
+    c->end = end;
+    for (;;) {
+        c->json = p;
+        parse_whitespace(c);
+        p = c->json;
+        if (p == end)
+            return PARSE_OK;
+        switch (sp->state)
+        {
+        case STREAM_DONE:
+            return PARSE_ROOT_NOT_SINGULAR;
+        case STREAM_COLON:
+            if (*p != ':')
+                return PARSE_MISS_COLON;
+            p++;
+            sp->state = STREAM_VALUE;
+            continue;
+        case STREAM_COMMA_OR_CLOSE: {
+            char kind = FRAME(c, sp->frame)->kind;
+            if (*p == ',') {
+                p++;
+                sp->state = kind == '[' ? STREAM_VALUE : STREAM_KEY;
+            }
+            else if (*p == (kind == '[' ? ']' : '}')) {
+                p++;
+                stream_close(sp);
+            }
+            else
+                return kind == '[' ? PARSE_MISS_COMMA_OR_SQUARE_BRACKET : PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+            continue;
+        }
+        case STREAM_KEY_OR_CLOSE:
+            if (*p == '}') {
+                p++;
+                stream_close(sp);
+                continue;
+            }
+            /* fall through */
+        case STREAM_KEY:
+            if (*p != '"')
+                return PARSE_MISS_KEY;
+            break;
+        case STREAM_VALUE_OR_CLOSE:
+            if (*p == ']') {
+                p++;
+                stream_close(sp);
+                continue;
+            }
+            /* fall through */
+        default:
+            if (*p == '[' || *p == '{') {
+                if ((ret = stream_open(sp, *p++)) != PARSE_OK)
+                    return ret;
+                continue;
+            }
+            break;
+        }
+
+        /* 字符串/数字/字面量: 先按完整的词法单元解析, 失败或停在块尾时再判断是否被截断 */
+        c->json = p;
+        if (*p == '"')
+            ret = parse_string_raw(c, &k, &klen);
+        else if (*p == 'n' || *p == 't' || *p == 'f')
+            ret = parse_literal(c, *p == 'n' ? "null" : *p == 't' ? "true" : "false");
+        else
+            ret = parse_number(c, &n);
+        if (!last && (ret != PARSE_OK || (c->json == end && *p != '"'))) {
+            if (*p == '"')
+                q = string_end(p + 1, end);
+            else {
+                for (q = p; q != end && ISTOKENCHAR(*q); q++)
+                    ;
+                q = q != end ? q : nullptr;
+            }
+            if (!q) {
+                sp->carry_len = 0;
+                sp->escape = 0;
+                if (*p == '"') {
+                    sp->carry_kind = '"';
+                    stream_append(sp, p, 1);
+                    stream_carry_string(sp, p + 1, end);
+                }
+                else {
+                    sp->carry_kind = 'v';
+                    stream_append(sp, p, end - p);
+                }
+                return PARSE_OK;
+            }
+        }
+        if (ret != PARSE_OK)
+            return ret;
+        if (sp->state == STREAM_KEY || sp->state == STREAM_KEY_OR_CLOSE) {
+            h.key(k, klen);
+            sp->state = STREAM_COLON;
+        }
+        else {
+            if (*p == '"')
+                h.string(k, klen);
+            else if (*p == 'n')
+                h.null();
+            else if (*p == 't' || *p == 'f')
+                h.boolean(*p == 't');
+            else
+                h.number(&n);
+            stream_value_done(sp);
+        }
+        p = c->json;
+    }
+}
+
+static void stream_reset(stream_parser* sp) {
+    sp->c.top = 0;
+    sp->frame = 0;
+    sp->depth = 0;
+    sp->state = STREAM_VALUE;
+    sp->error = PARSE_OK;
+    sp->carry_len = 0;
+    sp->carry_kind = 0;
+    sp->escape = 0;
+}
+
+stream_parser* stream_parser_create() {
+    stream_parser* sp = (stream_parser*)malloc(sizeof(stream_parser));
+    context_init(&sp->c, nullptr, 0);
+    sp->carry = nullptr;
+    sp->carry_cap = 0;
+    stream_reset(sp);
+    return sp;
+}
+
+void stream_parser_destroy(stream_parser* sp) {
+    if (!sp)
+        return;
+    if (!sp->error)
+        stream_discard(sp);
+    free(sp->c.stack);
+    free(sp->carry);
+    free(sp);
+}
+
+int feed(stream_parser* sp, const char* chunk, size_t len) {
+    const char *p = chunk, *end = chunk + len, *q;
+    assert(sp != nullptr && (chunk != nullptr || len == 0));
+    if (sp->error)
+        return sp->error;
+    if (sp->carry_kind) {
+        if (sp->carry_kind == '"')
+            q = stream_carry_string(sp, p, end);
+        else {
+            for (q = p; q != end && ISTOKENCHAR(*q); q++)
+                ;
+            stream_append(sp, p, q - p);
+            q = q != end ? q : nullptr;
+        }
+        if (!q)
+            return PARSE_OK;
+        sp->carry_kind = 0;
+        if ((sp->error = stream_run(sp, sp->carry, sp->carry + sp->carry_len, 1)) != PARSE_OK) {
+            stream_discard(sp);
+            return sp->error;
+        }
+        p = q;
+    }
+    if ((sp->error = stream_run(sp, p, end, 0)) != PARSE_OK)
+        stream_discard(sp);
+    return sp->error;
+}
+
+int finish(stream_parser* sp, value* v) {
+    int ret;
+    assert(sp != nullptr && v != nullptr);
+    init(v);
+    if ((ret = sp->error) == PARSE_OK) {
+        if (sp->carry_kind) {
+            sp->carry_kind = 0;
+            ret = stream_run(sp, sp->carry, sp->carry + sp->carry_len, 1);
+        }
+        /* 输入在此结束时 parse 会给出的错误 */
+        if (ret == PARSE_OK) {
+            switch (sp->state)
+            {
+            case STREAM_DONE:
+                memcpy(v, context_pop(&sp->c, sizeof(value)), sizeof(value));
+                break;
+            case STREAM_KEY:
+            case STREAM_KEY_OR_CLOSE:
+                ret = PARSE_MISS_KEY;
+                break;
+            case STREAM_COLON:
+                ret = PARSE_MISS_COLON;
+                break;
+            case STREAM_COMMA_OR_CLOSE:
+                ret = FRAME(&sp->c, sp->frame)->kind == '[' ? PARSE_MISS_COMMA_OR_SQUARE_BRACKET : PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+                break;
+            default:
+                ret = PARSE_EXPECT_VALUE;
+            }
+        }
+        if (ret != PARSE_OK)
+            stream_discard(sp);
+    }
+    stream_reset(sp);
+    return ret;
+}
+
+/*
+NDJSON: 合法 JSON 的字符串中不能出现未转义的换行, 因此每个 '\n' 都是记录边界.
+输入按字节均分为若干段, 每段从其后第一个行首开始; 第一遍各线程统计本段的行数和记录数,
+求前缀和之后第二遍各线程解析本段, 结果直接写入各自的位置, 因而保持输入顺序
+*/
+#ifndef NDJSON_MIN_RANGE
+#define NDJSON_MIN_RANGE 65536    /* 每个线程至少分到的字节数 */
+#endif
+
+struct ndjson_range
+{
+    const char* begin;
+    const char* end;
+    size_t lines, records;  /* 第一遍之后为本段的行数与记录数, 第二遍之前改为之前各段的累计 */
+};
+
+static inline const char* ndjson_line_end(const char* p, const char* end) {
+    const char* q = (const char*)memchr(p, '\n', end - p);
+    return q ? q : end;
+}
+
+static inline int ndjson_blank(const char* p, const char* q) {
+    while (p < q && (*p == ' ' || *p == '\t' || *p == '\r'))
+        p++;
+    return p == q;
+}
+
+static void ndjson_count(ndjson_range* r) {
+    const char* p, *q;
+    r->lines = r->records = 0;
+    for (p = r->begin; p < r->end; p = q + 1) {
+        q = ndjson_line_end(p, r->end);
+        r->lines++;
+        r->records += !ndjson_blank(p, q);
+        if (q == r->end)
+            break;
+    }
+}
+
+static void ndjson_parse(const ndjson_range* r, ndjson_record* out) {
+    const char* p, *q;
+    size_t line = r->lines;
+    parser ps;
+    parser_init(&ps, 0);
+    out += r->records;
+    for (p = r->begin; p < r->end; p = q + 1) {
+        q = ndjson_line_end(p, r->end);
+        line++;
+        if (!ndjson_blank(p, q)) {
+            out->line = line;
+            out->status = parse(&ps, &out->v, p, q - p);
+            out++;
+        }
+        if (q == r->end)
+            break;
+    }
+    parser_release(&ps);
+}
+
+int parse_ndjson(const char* json, size_t len, ndjson_record** records, size_t* count, unsigned threads) {
+    const char* end = json + len, *p;
+    ndjson_record* out;
+    ndjson_range* r;
+    std::thread* th;
+    size_t n, i, lines = 0, total = 0;
+    assert((json != nullptr || len == 0) && records != nullptr && count != nullptr);
+    if (threads == 0 && (threads = std::thread::hardware_concurrency()) == 0)
+        threads = 1;
+    n = len / NDJSON_MIN_RANGE;
+    n = n > threads ? threads : n > 0 ? n : 1;
+    r = (ndjson_range*)malloc(n * sizeof(ndjson_range));
+    for (i = 0; i < n; i++) {
+        p = json + len / n * i;
+        if (p > json && p[-1] != '\n' && (p = ndjson_line_end(p, end)) < end)
+            p++;
+        r[i].begin = p;
+        if (i > 0)
+            r[i - 1].end = p;
+    }
+    r[n - 1].end = end;
+
+    th = n > 1 ? new std::thread[n - 1] : nullptr;
+    for (i = 1; i < n; i++)
+        th[i - 1] = std::thread(ndjson_count, &r[i]);
+    ndjson_count(&r[0]);
+    for (i = 1; i < n; i++)
+        th[i - 1].join();
+    for (i = 0; i < n; i++) {
+        size_t l = r[i].lines, k = r[i].records;
+        r[i].lines = lines;
+        r[i].records = total;
+        lines += l;
+        total += k;
+    }
+
+    out = (ndjson_record*)malloc(total * sizeof(ndjson_record));
+    for (i = 1; i < n; i++)
+        th[i - 1] = std::thread(ndjson_parse, &r[i], out);
+    ndjson_parse(&r[0], out);
+    for (i = 1; i < n; i++)
+        th[i - 1].join();
+    delete[] th;
+    free(r);
+
+    *records = out;
+    *count = total;
+    for (i = 0; i < total; i++)
+        if (out[i].status != PARSE_OK)
+            return out[i].status;
+    return PARSE_OK;
+}
+
+void free_ndjson(ndjson_record* records, size_t count) {
+    size_t i;
+    assert(records != nullptr || count == 0);
+    for (i = 0; i < count; i++)
+        Free(&records[i].v);
+    free(records);
+}
+
+/*
+两阶段解析
+第一阶段: 每 64 字节为一块, 用位掩码求出被转义的字节和字符串内外, 把字符串外的结构字符、
+每个字符串的首尾引号以及每个标量 (数字/字面量) 的起点依次记入索引.
+第二阶段: 沿索引建树, 不再逐字节跳过空白或扫描字符串; 含反斜杠的字符串在索引中带标记,
+仍由 parse_string_raw 解码. 第一阶段发现字符串未闭合或含控制字符, 或第二阶段遇到任何错误时,
+改用 parse 重新解析, 以得到与 parse 完全相同的错误码.
+多线程时先并行求出每段中未转义引号数的奇偶, 由此得到每段开头是否在字符串内, 再并行建立各段的索引
+*/
+#ifndef INDEX_MIN_RANGE
+#define INDEX_MIN_RANGE (1 << 20)   /* 第一阶段每个线程至少分到的字节数 */
+#endif
+
+#define INDEX_ESCAPED 0x80000000u   /* 索引项: 该字符串含有反斜杠 */
+#define INDEX_POS(t) ((t) & ~INDEX_ESCAPED)
+
+struct block_masks
+{
+    uint64_t structural, whitespace, quote, backslash, control;
+};
+
+/* 64 字节块中各类字符的位置 */
+#ifdef EASYJSON_SSE2
+static inline void classify_block(const char* p, block_masks* m) {
+    const __m128i lcurly = _mm_set1_epi8('{'), rcurly = _mm_set1_epi8('}'), colon = _mm_set1_epi8(':');
+    const __m128i comma = _mm_set1_epi8(','), lower = _mm_set1_epi8(0x20);
+    const __m128i sp = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t');
+    const __m128i lf = _mm_set1_epi8('\n'), cr = _mm_set1_epi8('\r');
+    const __m128i quote = _mm_set1_epi8('"'), slash = _mm_set1_epi8('\\'), ctrl = _mm_set1_epi8(0x1F);
+    int i;
+    m->structural = m->whitespace = m->quote = m->backslash = m->control = 0;
+    for (i = 0; i < 4; i++) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(p + 16 * i));
+        __m128i y = _mm_or_si128(x, lower);     /* '[' ']' 变为 '{' '}' */
+        __m128i s = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(y, lcurly), _mm_cmpeq_epi8(y, rcurly)),
+                                 _mm_or_si128(_mm_cmpeq_epi8(x, colon), _mm_cmpeq_epi8(x, comma)));
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, sp), _mm_cmpeq_epi8(x, tab)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(x, lf), _mm_cmpeq_epi8(x, cr)));
+        m->structural |= (uint64_t)(unsigned)_mm_movemask_epi8(s) << (16 * i);
+        m->whitespace |= (uint64_t)(unsigned)_mm_movemask_epi8(ws) << (16 * i);
+        m->quote |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, quote)) << (16 * i);
+        m->backslash |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, slash)) << (16 * i);
+        m->control |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(x, ctrl), x)) << (16 * i);
+    }
+}
+#else
+static inline void classify_block(const char* p, block_masks* m) {
+    int i;
+    m->structural = m->whitespace = m->quote = m->backslash = m->control = 0;
+    for (i = 0; i < 64; i++) {
+        uint64_t bit = (uint64_t)1 << i;
+        switch (p[i])
+        {
+        case '{': case '}': case '[': case ']': case ':': case ',':
+            m->structural |= bit;
+            break;
+        case ' ':
+            m->whitespace |= bit;
+            break;
+        case '\t': case '\n': case '\r':
+            m->whitespace |= bit;
+            m->control |= bit;
+            break;
+        case '"':
+            m->quote |= bit;
+            break;
+        case '\\':
+            m->backslash |= bit;
+            break;
+        default:
+            if ((unsigned char)p[i] < 0x20)
+                m->control |= bit;
+        }
+    }
+}
+#endif
+
+/* 第 i 位为第 0..i 位的异或: 从引号起到下一个引号之前为 1 */
+static inline uint64_t prefix_xor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+/* 未被转义的引号; *escaped 为上一块末尾留下的转义 (本块首字节被转义) */
+static inline uint64_t block_quotes(uint64_t quote, uint64_t backslash, uint64_t* escaped) {
+    uint64_t e = *escaped, bs = backslash & ~*escaped;
+    /* 反斜杠少见, 逐个处理: 未被转义的反斜杠转义其后一个字节 */
+    *escaped = 0;
+    while (bs) {
+        unsigned i = CTZ64(bs);
+        bs &= bs - 1;
+        if (i == 63)
+            *escaped = 1;
+        else {
+            e |= (uint64_t)2 << i;
+            bs &= ~((uint64_t)2 << i);
+        }
+    }
+    return quote & ~e;
+}
+
+/* 输入末尾不足 64 字节的块补空格 */
+static inline const char* index_load(const char* p, const char* end, char* buf) {
+    if (end - p >= 64)
+        return p;
+    memset(buf, ' ', 64);
+    memcpy(buf, p, end - p);
+    return buf;
+}
+
+struct index_range
+{
+    const char* begin;      /* 相对输入开头 64 字节对齐 */
+    const char* end;
+    uint64_t escaped;       /* 进入本段时的状态, 第一阶段之后为离开时的状态 */
+    uint64_t in_string;     /* 全 1 表示在字符串内 */
+    uint64_t scalar;        /* 前一字节属于标量 */
+    uint64_t control;       /* 字符串内出现过控制字符 */
+    uint32_t* t;
+    size_t n, cap;
+    int escape_prev;        /* 本段开头所在的字符串 (起始引号在之前的段) 含有反斜杠 */
+};
+
+static void index_block(index_range* r, const char* p, uint32_t base) {
+    block_masks m;
+    uint64_t quote, inside, other, emit, esc;
+    uint32_t* out = r->t + r->n;
+    classify_block(p, &m);
+    quote = block_quotes(m.quote, m.backslash, &r->escaped);
+    inside = prefix_xor(quote) ^ r->in_string;     /* 含起始引号, 不含结束引号 */
+    r->in_string = (uint64_t)((int64_t)inside >> 63);
+    other = ~(m.structural | m.whitespace | quote | inside);
+    emit = (m.structural & ~inside) | quote | (other & ~((other << 1) | r->scalar));
+    r->scalar = other >> 63;
+    r->control |= m.control & inside;
+    esc = m.backslash & inside;
+    if (!esc) {
+        while (emit) {
+            *out++ = base + CTZ64(emit);
+            emit &= emit - 1;
+        }
+    }
+    else {
+        /* 字符串内的反斜杠标记在该字符串的起始引号上, 即此前最后一个索引项 */
+        for (emit |= esc; emit; emit &= emit - 1) {
+            unsigned i = CTZ64(emit);
+            if (!(esc >> i & 1))
+                *out++ = base + i;
+            else if (out != r->t)
+                out[-1] |= INDEX_ESCAPED;
+            else
+                r->escape_prev = 1;
+        }
+    }
+    r->n = out - r->t;
+}
+
+static void index_build(index_range* r, const char* json) {
+    const char* p;
+    char buf[64];
+    for (p = r->begin; p < r->end; p += 64) {
+        if (r->cap - r->n < 64) {
+            r->cap = r->cap ? r->cap + (r->cap >> 1) : (size_t)(r->end - r->begin) / 8 + 64;
+            r->t = (uint32_t*)realloc(r->t, r->cap * sizeof(uint32_t));
+        }
+        index_block(r, index_load(p, r->end, buf), (uint32_t)(p - json));
+    }
+}
+
+/* 本段中未转义引号数的奇偶, 结果存在 in_string */
+static void index_parity(index_range* r) {
+    const char* p;
+    char buf[64];
+    block_masks m;
+    uint64_t parity = 0;
+    for (p = r->begin; p < r->end; p += 64) {
+        classify_block(index_load(p, r->end, buf), &m);
+        parity ^= prefix_xor(block_quotes(m.quote, m.backslash, &r->escaped));
+    }
+    r->in_string = (uint64_t)((int64_t)parity >> 63);
+}
+
+/* 第一阶段: 成功时返回索引, 字符串未闭合或含控制字符时返回 nullptr */
+static uint32_t* index_stage1(const char* json, size_t len, unsigned threads, size_t* count) {
+    index_range* r;
+    std::thread* th = nullptr;
+    uint32_t* t;
+    const char* q;
+    size_t n, i, total = 0;
+    uint64_t in_string = 0, control = 0;
+    if (threads == 0 && (threads = std::thread::hardware_concurrency()) == 0)
+        threads = 1;
+    n = len / INDEX_MIN_RANGE;
+    n = n > threads ? threads : n > 0 ? n : 1;
+    r = (index_range*)calloc(n, sizeof(index_range));
+    for (i = 0; i < n; i++) {
+        r[i].begin = json + ((len / n * i) & ~(size_t)63);
+        r[i].end = json + len;
+        if (i > 0)
+            r[i - 1].end = r[i].begin;
+        /* 反斜杠序列的奇偶决定本段首字节是否被转义 */
+        for (q = r[i].begin; q > json && q[-1] == '\\'; q--)
+            ;
+        r[i].escaped = (r[i].begin - q) & 1;
+    }
+    if (n > 1) {
+        th = new std::thread[n - 1];
+        for (i = 1; i < n; i++)
+            th[i - 1] = std::thread(index_parity, &r[i]);
+        index_parity(&r[0]);
+        for (i = 1; i < n; i++)
+            th[i - 1].join();
+        for (i = 0; i < n; i++) {
+            uint64_t parity = r[i].in_string;
+            const char* b = r[i].begin;
+            r[i].in_string = in_string;
+            in_string ^= parity;
+            for (q = b; q > json && q[-1] == '\\'; q--)
+                ;
+            r[i].escaped = (b - q) & 1;
+            /* 前一字节在字符串外且不是空白、结构字符或引号时, 本段开头在一个标量中间 */
+            if (i > 0 && !r[i].in_string) {
+                char ch = b[-1];
+                int quoted = ch == '"';
+                if (quoted) {
+                    for (q = b - 1; q > json && q[-1] == '\\'; q--)
+                        ;
+                    quoted = !((b - 1 - q) & 1);
+                }
+                r[i].scalar = !(ISWHITESPACE(ch) || ch == '{' || ch == '}' || ch == '[' || ch == ']' ||
+                                ch == ':' || ch == ',' || quoted);
+            }
+        }
+        for (i = 1; i < n; i++)
+            th[i - 1] = std::thread(index_build, &r[i], json);
+    }
+    index_build(&r[0], json);
+    for (i = 1; i < n; i++)
+        th[i - 1].join();
+    delete[] th;
+
+    for (i = 0; i < n; i++) {
+        total += r[i].n;
+        control |= r[i].control;
+    }
+    if (n == 1) {
+        t = r[0].t;
+        r[0].t = nullptr;
+    }
+    else {
+        t = (uint32_t*)malloc((total + 1) * sizeof(uint32_t));
+        for (i = 0, total = 0; i < n; i++) {
+            if (r[i].escape_prev)
+                t[total - 1] |= INDEX_ESCAPED;
+            memcpy(t + total, r[i].t, r[i].n * sizeof(uint32_t));
+            total += r[i].n;
+        }
+    }
+    in_string = r[n - 1].in_string;
+    for (i = 0; i < n; i++)
+        free(r[i].t);
+    free(r);
+    if (in_string || control) {
+        free(t);
+        return nullptr;
+    }
+    *count = total;
+    return t;
+}
+
+/* 第二阶段: 索引项 k 处的字符串, 不含反斜杠的直接指向输入 */
+static int index_string(context* c, const char* json, const uint32_t* t, size_t k, char** s, size_t* len) {
+    if (t[k] & INDEX_ESCAPED) {
+        c->json = json + INDEX_POS(t[k]);
+        return parse_string_raw(c, s, len);
+    }
+    *s = (char*)json + t[k] + 1;
+    *len = t[k + 1] - t[k] - 1;
+    return PARSE_OK;
+}
+
+/* 键 ':' */
+static int index_member_key(context* c, dom_handler& h, const char* json, const uint32_t* t, size_t n, size_t* k, int* keyed) {
+    char* s;
+    size_t len;
+    int ret;
+    if (*k == n || json[INDEX_POS(t[*k])] != '"')
+        return PARSE_MISS_KEY;
+    if ((ret = index_string(c, json, t, *k, &s, &len)) != PARSE_OK)
+        return ret;
+    h.key(s, len);
+    *keyed = 1;
+    *k += 2;
+    if (*k == n || json[INDEX_POS(t[*k])] != ':')
+        return PARSE_MISS_COLON;
+    ++*k;
+    return PARSE_OK;
+}
+
+/* 与 parse_value 相同的文法, 词法单元取自索引; 出错只需返回非 PARSE_OK, 错误码由 parse 重新给出 */
+static int index_parse(context* c, dom_handler& h, const char* json, const uint32_t* t, size_t n) {
+    size_t cur = 0, depth = 0, k = 0, len;
+    int ret, keyed = 0, opened;
+    const char* p;
+    char* s;
+    value num;
+    for (;;) {
+        opened = 0;
+        if (k == n) {
+            ret = PARSE_EXPECT_VALUE;
+            break;
+        }
+        p = json + INDEX_POS(t[k]);
+        switch (*p)
+        {
+        case '"':
+            if ((ret = index_string(c, json, t, k, &s, &len)) == PARSE_OK)
+                h.string(s, len);
+            k += 2;
+            break;
+        case '[':
+        case '{':
+            if (depth == PARSE_MAX_DEPTH) {
+                ret = PARSE_TOO_DEEP;
+                break;
+            }
+            frame_open(c, &cur, *p);
+            depth++;
+            keyed = 0;
+            if (++k < n && json[INDEX_POS(t[k])] == (*p == '[' ? ']' : '}')) {
+                k++;
+                frame_end(c, h, &cur);
+                depth--;
+                ret = PARSE_OK;
+            }
+            else {
+                ret = *p == '[' ? PARSE_OK : index_member_key(c, h, json, t, n, &k, &keyed);
+                opened = 1;
+            }
+            break;
+        case ']':
+        case '}':
+        case ',':
+        case ':':
+            ret = PARSE_EXPECT_VALUE;
+            break;
+        default:
+            c->json = p;
+            ret = *p == 'n' ? parse_literal(c, "null") : *p == 't' ? parse_literal(c, "true") :
+                  *p == 'f' ? parse_literal(c, "false") : parse_number(c, &num);
+            if (ret != PARSE_OK)
+                break;
+            /* 标量之后须是空白或下一个索引项 */
+            if (++k < n ? c->json != json + INDEX_POS(t[k]) && !ISWHITESPACE(*c->json) :
+                          c->json != c->end && !ISWHITESPACE(*c->json))
+                ret = PARSE_INVALID_VALUE;
+            else if (*p == 'n')
+                h.null();
+            else if (*p == 't' || *p == 'f')
+                h.boolean(*p == 't');
+            else
+                h.number(&num);
+            break;
+        }
+        if (ret != PARSE_OK)
+            break;
+        if (opened)
+            continue;
+
+        for (;;) {
+            frame* f;
+            char ch;
+            if (!cur)
+                return k == n ? PARSE_OK : PARSE_ROOT_NOT_SINGULAR;
+            f = FRAME(c, cur);
+            f->size++;
+            keyed = 0;
+            ch = k < n ? json[INDEX_POS(t[k])] : '\0';
+            if (ch == ',') {
+                k++;
+                if (f->kind == '{')
+                    ret = index_member_key(c, h, json, t, n, &k, &keyed);
+                break;
+            }
+            if (ch != (f->kind == '[' ? ']' : '}')) {
+                ret = f->kind == '[' ? PARSE_MISS_COMMA_OR_SQUARE_BRACKET : PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+                break;
+            }
+            k++;
+            frame_end(c, h, &cur);
+            depth--;
+        }
+        if (ret != PARSE_OK)
+            break;
+    }
+    frame_discard(c, h, &cur, keyed);
+    return ret;
+}
+
+int parse_indexed(value* v, const char* json, size_t len, unsigned threads) {
+    context c;
+    dom_handler h = { &c };
+    uint32_t* t;
+    size_t n;
+    int ret;
+    assert(v != nullptr && (json != nullptr || len == 0));
+    if (len >= INDEX_ESCAPED || !(t = index_stage1(json, len, threads, &n)))
+        return parse(v, json, len);
+    init(v);
+    context_init(&c, json, len);
+    if ((ret = index_parse(&c, h, json, t, n)) == PARSE_OK)
+        memcpy(v, context_pop(&c, sizeof(value)), sizeof(value));
+    else if (c.top)     /* 根之后还有内容 */
+        Free((value*)context_pop(&c, sizeof(value)));
+    assert(c.top == 0);
+    free(t);
+    free(c.stack);
+    return ret == PARSE_OK ? PARSE_OK : parse(v, json, len);
+}
+
+#ifndef PARSE_STRINGIFY_INIT_SIZE
+#define PARSE_STRINGIFY_INIT_SIZE 256
+#endif
+
+/* 输出到 sink 时栈上缓冲区的大小, 即每次交给 sink 的最大字节数 */
+#ifndef STRINGIFY_SINK_SIZE
+#define STRINGIFY_SINK_SIZE 4096
+#endif
+
+static const char digits_lut[200] = {
+    '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+    '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+    '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+    '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+    '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+    '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+    '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+    '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+    '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+    '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+};
+
+/* 写出无符号整数, 返回写入后的位置 */
+static char* u64toa(uint64_t x, char* out) {
+    char tmp[20], *p = tmp + sizeof(tmp);
+    size_t n;
+    while (x >= 100) {
+        unsigned i = (unsigned)(x % 100) * 2;
+        x /= 100;
+        *--p = digits_lut[i + 1];
+        *--p = digits_lut[i];
+    }
+    if (x >= 10) {
+        *--p = digits_lut[x * 2 + 1];
+        *--p = digits_lut[x * 2];
+    }
+    else
+        *--p = (char)('0' + x);
+    memcpy(out, p, n = tmp + sizeof(tmp) - p);
+    return out + n;
+}
+
+/*
+double 转最短往返十进制 (Grisu2): v 的上下边界乘以 10 的幂后逐位生成数字,
+在两边界之间的数字串都能解析回 v. 10 的幂取自 pow5_128
+*/
+struct diyfp
+{
+    uint64_t f;
+    int e;
+};
+
+static diyfp diyfp_mul(diyfp a, diyfp b) {
+    uint64_t hi, lo = umul128(a.f, b.f, &hi);
+    diyfp r;
+    r.f = hi + (lo >> 63);  /* 舍入 */
+    r.e = a.e + b.e + 64;
+    return r;
+}
+
+static diyfp diyfp_normalize(diyfp a) {
+    int s = CLZ64(a.f);
+    a.f <<= s;
+    a.e -= s;
+    return a;
+}
+
+/* 10^k 的 64 位近似 */
+static diyfp cached_pow10(int k) {
+    const uint64_t* t = pow5_128 + 2 * (k + 342);
+    diyfp r;
+    assert(k >= -342 && k <= 340);
+    r.f = t[0] + (t[1] >> 63);
+    r.e = ((217706 * k) >> 16) - 63;    /* floor(k * log2(10)) - 63 */
+    if (r.f == 0) {
+        r.f = (uint64_t)1 << 63;
+        r.e++;
+    }
+    return r;
+}
+
+static void grisu_round(char* buffer, int len, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t wp_w) {
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+        buffer[len - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+static const uint64_t pow10_u64[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL
+};
+
+static void digit_gen(diyfp w, diyfp mp, uint64_t delta, char* buffer, int* len, int* K) {
+    const int shift = -mp.e;
+    const uint64_t one = (uint64_t)1 << shift, wp_w = mp.f - w.f;
+    uint32_t p1 = (uint32_t)(mp.f >> shift);
+    uint64_t p2 = mp.f & (one - 1);
+    int kappa = 1;
+    while (kappa < 10 && p1 >= pow10_u64[kappa])
+        kappa++;
+    *len = 0;
+    while (kappa > 0) {
+        uint32_t d = p1 / (uint32_t)pow10_u64[kappa - 1];
+        p1 %= (uint32_t)pow10_u64[kappa - 1];
+        if (d || *len)
+            buffer[(*len)++] = (char)('0' + d);
+        kappa--;
+        uint64_t rest = ((uint64_t)p1 << shift) + p2;
+        if (rest <= delta) {
+            *K += kappa;
+            grisu_round(buffer, *len, delta, rest, pow10_u64[kappa] << shift, wp_w);
+            return;
+        }
+    }
+    for (;;) {
+        p2 *= 10;
+        delta *= 10;
+        char d = (char)(p2 >> shift);
+        if (d || *len)
+            buffer[(*len)++] = (char)('0' + d);
+        p2 &= one - 1;
+        kappa--;
+        if (p2 < delta) {
+            *K += kappa;
+            grisu_round(buffer, *len, delta, p2, one, -kappa < 20 ? wp_w * pow10_u64[-kappa] : 0);
+            return;
+        }
+    }
+}
+
+/* v > 0 且有限, 生成数字串, 数值为 buffer * 10^K */
+static void grisu2(double d, char* buffer, int* len, int* K) {
+    uint64_t bits;
+    diyfp v, pl, mi, c, W, Wp, Wm;
+    int mk;
+    memcpy(&bits, &d, sizeof(bits));
+    if (bits >> 52) {
+        v.f = (bits & DOUBLE_FRAC_MASK) | ((uint64_t)1 << 52);
+        v.e = (int)(bits >> 52) - 1075;
+    }
+    else {
+        v.f = bits & DOUBLE_FRAC_MASK;
+        v.e = -1074;
+    }
+    /* 与相邻 double 的中点作为上下边界 */
+    pl.f = (v.f << 1) + 1;
+    pl.e = v.e - 1;
+    pl = diyfp_normalize(pl);
+    if (v.f == (uint64_t)1 << 52 && v.e > -1074) {
+        mi.f = (v.f << 2) - 1;
+        mi.e = v.e - 2;
+    }
+    else {
+        mi.f = (v.f << 1) - 1;
+        mi.e = v.e - 1;
+    }
+    mi.f <<= mi.e - pl.e;
+    mi.e = pl.e;
+    /* 选 10^mk 使乘积的二进制指数落在 [-60, -56] */
+    mk = (int)ceil((-61 - pl.e) * 0.30102999566398114);
+    c = cached_pow10(mk);
+    W = diyfp_mul(diyfp_normalize(v), c);
+    Wp = diyfp_mul(pl, c);
+    Wm = diyfp_mul(mi, c);
+    Wm.f++;
+    Wp.f--;
+    *K = -mk;
+    digit_gen(W, Wp, Wp.f - Wm.f, buffer, len, K);
+}
+
+/*
+Grisu2 偶尔会多生成一位. 16 位以上时尝试去掉最后一位(截断或进一),
+用 eisel_lemire 精确验证能否读回同一个 double
+*/
+static void grisu_shorten(char* digits, int* len, int* K, uint64_t bits) {
+    while (*len >= 16) {
+        uint64_t w = 0, cand[2];
+        int i, n;
+        for (i = 0; i < *len - 1; i++)
+            w = w * 10 + (digits[i] - '0');
+        cand[0] = digits[*len - 1] >= '5' ? w + 1 : w;
+        cand[1] = digits[*len - 1] >= '5' ? w : w + 1;
+        for (i = 0; i < 2 && eisel_lemire(cand[i], *K + 1) != bits; i++)
+            ;
+        if (i == 2)
+            return;
+        for (w = cand[i], n = 0; w % 10 == 0; n++)  /* 进位可能产生末尾的 0 */
+            w /= 10;
+        *len = (int)(u64toa(w, digits) - digits);
+        *K += 1 + n;
+    }
+}
+
+/*
+写出 double: 小于 2^53 的整数走快速路径, 否则写最短往返的数字, 格式同 %.17g (指数 < -4 或 >= 17 时用科学计数法).
+2^53 以上的整数值也用科学计数法: 写成整数会被读回为 int64, 且补 0 后的值与原 double 不同
+*/
+static char* dtoa(double d, char* out) {
+    char* p = out;
+    char digits[20];
+    int len, K, x;
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    if ((bits >> 52 & 0x7FF) == 0x7FF) {   /* JSON 不能表示 inf/nan */
+        memcpy(out, "null", 4);
+        return out + 4;
+    }
+    if (bits >> 63) {
+        *p++ = '-';
+        d = -d;
+    }
+    if (d < 9007199254740992.0 && d == (double)(uint64_t)d)
+        return u64toa((uint64_t)d, p);
+
+    grisu2(d, digits, &len, &K);
+    memcpy(&bits, &d, sizeof(bits));
+    grisu_shorten(digits, &len, &K, bits);
+    x = len + K - 1;    /* 科学计数法的指数 */
+    if (x < -4 || x >= 17 || len <= x + 1) {
+        *p++ = digits[0];
+        if (len > 1) {
+            *p++ = '.';
+            memcpy(p, digits + 1, len - 1);
+            p += len - 1;
+        }
+        *p++ = 'e';
+        *p++ = x < 0 ? '-' : '+';
+        if (x < 0)
+            x = -x;
+        if (x < 10)
+            *p++ = '0';
+        return u64toa((uint64_t)x, p);
+    }
+    if (x < 0) {    /* 0.00ddd */
+        *p++ = '0';
+        *p++ = '.';
+        memset(p, '0', -x - 1);
+        p += -x - 1;
+        memcpy(p, digits, len);
+        return p + len;
+    }
+    memcpy(p, digits, x + 1);   /* dd.ddd */
+    p += x + 1;
+    *p++ = '.';
+    memcpy(p, digits + x + 1, len - x - 1);
+    return p + len - x - 1;
+}
+
+static char* escape_string(char* p, const char* s, size_t len) {
+    static const char hex_digits[] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
+    size_t i;
+    for (i = 0; i < len; i++) {
+        unsigned char ch = (unsigned char)s[i];
+        switch (ch) {
+            case '\"': *p++ = '\\'; *p++ = '\"'; break;
+            case '\\': *p++ = '\\'; *p++ = '\\'; break;
+            case '\b': *p++ = '\\'; *p++ = 'b';  break;
+            case '\f': *p++ = '\\'; *p++ = 'f';  break;
+            case '\n': *p++ = '\\'; *p++ = 'n';  break;
+            case '\r': *p++ = '\\'; *p++ = 'r';  break;
+            case '\t': *p++ = '\\'; *p++ = 't';  break;
+            default:
+                if (ch < 0x20) {
+                    *p++ = '\\'; *p++ = 'u'; *p++ = '0'; *p++ = '0';
+                    *p++ = hex_digits[ch >> 4];
+                    *p++ = hex_digits[ch & 15];
+                }
+                else
+                    *p++ = s[i];
+        }
+    }
+    return p;
+}
+
+static void stringify_string(context* c, const char* s, size_t len) {
+    size_t size;
+    char* head, *p;
+    assert(s != nullptr);
+    if (c->sink) {
+        /* 分段转义, 每段最多 6 倍膨胀也能放进缓冲区 */
+        size_t n = c->size > 6 ? (c->size - 1) / 6 : 1;
+        PUTC(c, '"');
+        while (len) {
+            size_t m = len < n ? len : n;
+            p = head = (char*)context_push(c, size = m * 6);
+            p = escape_string(p, s, m);
+            c->top -= size - (p - head);
+            s += m;
+            len -= m;
+        }
+        PUTC(c, '"');
+        return;
+    }
+    p = head = (char*)context_push(c, size = len * 6 + 2); /* "\u00xx..." */
+    *p++ = '"';
+    p = escape_string(p, s, len);
+    *p++ = '"';
+    c->top -= size - (p - head);
+}
+
+/*
+stringify/Free 的遍历栈: 记录各层容器与当前子节点下标.
+输出时 context 栈就是输出缓冲区, 因此另用一个先放在调用方栈上、不够时再移到堆上的数组
+*/
+#define WALK_LOCAL_SIZE 32
+
+struct walk_frame
+{
+    const value* v;
+    size_t i;
+};
+
+struct walk_stack
+{
+    walk_frame* f;
+    size_t top, cap;
+    walk_frame local[WALK_LOCAL_SIZE];
+};
+
+static void walk_init(walk_stack* w) {
+    w->f = w->local;
+    w->top = 0;
+    w->cap = WALK_LOCAL_SIZE;
+}
+
+static void walk_push(walk_stack* w, const value* v) {
+    if (w->top == w->cap) {
+        walk_frame* f = (walk_frame*)malloc(sizeof(walk_frame) * (w->cap *= 2));
+        memcpy(f, w->f, sizeof(walk_frame) * w->top);
+        if (w->f != w->local)
+            free(w->f);
+        w->f = f;
+    }
+    w->f[w->top].v = v;
+    w->f[w->top++].i = 0;
+}
+
+static void walk_release(walk_stack* w) {
+    if (w->f != w->local)
+        free(w->f);
+}
+
+#define CHILD_COUNT(x) ((x)->type == EASYJson_ARRAY ? (x)->u.a.size : (x)->u.o.size)
+#define CHILD(x, i) ((x)->type == EASYJson_ARRAY ? &(x)->u.a.e[i] : &(x)->u.o.m[i].v)
+
+static void stringify_value(context* c, const value* v) {
+    walk_stack w;
+    walk_init(&w);
+    for (;;) {
+        /* 输出 v; 非空容器输出开头后入栈, 转去第一个子节点 */
+        switch (v->type) {
+            case EASYJson_NULL:   PUTS(c, "null",  4); break;
+            case EASYJson_FALSE:  PUTS(c, "false", 5); break;
+            case EASYJson_TRUE:   PUTS(c, "true",  4); break;
+            case EASYJson_NUMBER: {
+                char* p = (char*)context_push(c, 32), *q = p;
+                if (v->flags & FLAG_UINT64)
+                    q = u64toa(v->u.u64, q);
+                else if (v->flags & FLAG_INT64) {
+                    if (v->u.i64 < 0)
+                        *q++ = '-';
+                    q = u64toa(v->u.i64 < 0 ? 0 - (uint64_t)v->u.i64 : (uint64_t)v->u.i64, q);
+                }
+                else
+                    q = dtoa(v->u.n, q);
+                c->top -= 32 - (q - p);
+                break;
+            }
+            case EASYJson_STRING: stringify_string(c, get_string(v), get_string_length(v)); break;
+            case EASYJson_ARRAY:
+                if (v->u.a.size == 0) {
+                    PUTS(c, "[]", 2);
+                    break;
+                }
+                PUTC(c, '[');
+                walk_push(&w, v);
+                v = &v->u.a.e[0];
+                continue;
+            case EASYJson_OBJECT:
+                if (v->u.o.size == 0) {
+                    PUTS(c, "{}", 2);
+                    break;
+                }
+                PUTC(c, '{');
+                walk_push(&w, v);
+                stringify_string(c, v->u.o.m[0].k, v->u.o.m[0].klen);
+                PUTC(c, ':');
+                v = &v->u.o.m[0].v;
+                continue;
+            default: assert(0 && "invalid type");
+        }
+        /* 子节点完成: 转去下一个兄弟, 没有则输出结尾并回到上一层 */
+        for (;;) {
+            walk_frame* f;
+            if (w.top == 0) {
+                walk_release(&w);
+                return;
+            }
+            f = &w.f[w.top - 1];
+            if (++f->i < CHILD_COUNT(f->v)) {
+                PUTC(c, ',');
+                if (f->v->type == EASYJson_OBJECT) {
+                    stringify_string(c, f->v->u.o.m[f->i].k, f->v->u.o.m[f->i].klen);
+                    PUTC(c, ':');
+                }
+                v = CHILD(f->v, f->i);
+                break;
+            }
+            PUTC(c, f->v->type == EASYJson_ARRAY ? ']' : '}');
+            w.top--;
+        }
+    }
+}
+
+char* stringify(const value* v, size_t* length) {
+    context c;
+    assert(v != nullptr);
+    c.stack = (char*)malloc(c.size = PARSE_STRINGIFY_INIT_SIZE);
+    c.top = 0;
+    c.sink = nullptr;
+    stringify_value(&c, v);
+    if (length)
+        *length = c.top;
+    PUTC(&c, '\0');
+    return c.stack;
+}
+
+int stringify_sink(const value* v, sink_func sink, void* user, char* buf, size_t size) {
+    context c;
+    assert(v != nullptr && sink != nullptr && buf != nullptr && size > 0);
+    c.stack = buf;
+    c.size = size;
+    c.top = 0;
+    c.sink = sink;
+    c.owned = 0;
+    c.user = user;
+    c.failed = 0;
+    stringify_value(&c, v);
+    context_flush(&c);
+    if (c.owned)
+        free(c.stack);
+    return c.failed ? PARSE_TERMINATED : PARSE_OK;
+}
+
+int stringify_sink(const value* v, sink_func sink, void* user) {
+    char buf[STRINGIFY_SINK_SIZE];
+    return stringify_sink(v, sink, user, buf, sizeof(buf));
+}
+
+static int sink_fd(void* user, const char* s, size_t len) {
+    int fd = *(int*)user;
+    while (len) {
+        ssize_t n = write(fd, s, len);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return 0;
+        s += n;
+        len -= n;
+    }
+    return 1;
+}
+
+int stringify_fd(const value* v, int fd) {
+    return stringify_sink(v, sink_fd, &fd);
+}
+
+static int sink_string(void* user, const char* s, size_t len) {
+    ((std::string*)user)->append(s, len);
+    return 1;
+}
+
+int stringify_to_string(const value* v, std::string* out) {
+    assert(out != nullptr);
+    return stringify_sink(v, sink_string, out);
+}
+
+/* 释放 v 自身持有的存储, 子节点与各成员的键须已释放 */
+static void free_node(value* v) {
+    switch (v->type)
+    {
+    case EASYJson_STRING:
+        if (!(v->flags & (FLAG_BORROWED | FLAG_INLINE)))
+            free(v->u.s.s);
+        break;
+    case EASYJson_ARRAY:
+        if (!(v->flags & FLAG_BORROWED))
+            free(v->u.a.e);
+        break;
+    case EASYJson_OBJECT:
+        if (!(v->flags & FLAG_BORROWED))
+            free(v->u.o.m);
+        free(v->u.o.index);
+        break;
+    default:
+        break;
+    }
+    v->type = EASYJson_NULL;
+    v->flags = 0;
+}
+
+#define HAS_CHILDREN(x) (((x)->type == EASYJson_ARRAY || (x)->type == EASYJson_OBJECT) && CHILD_COUNT(x))
+
+void writer_init(writer* w, size_t keep) {
+    assert(w != nullptr);
+    w->stack = nullptr;
+    w->size = 0;
+    w->keep = keep;
+}
+
+void writer_release(writer* w) {
+    assert(w != nullptr);
+    free(w->stack);
+    w->stack = nullptr;
+    w->size = 0;
+}
+
+const char* stringify(writer* w, const value* v, size_t* length) {
+    context c;
+    assert(w != nullptr && v != nullptr);
+    /* 上次的结果此时才不再需要, 超过 keep 的缓冲区在这里释放 */
+    if (w->keep && w->size > w->keep)
+        writer_release(w);
+    if (!w->stack)
+        w->stack = (char*)malloc(w->size = PARSE_STRINGIFY_INIT_SIZE);
+    c.stack = w->stack;
+    c.size = w->size;
+    c.top = 0;
+    c.sink = nullptr;
+    stringify_value(&c, v);
+    if (length)
+        *length = c.top;
+    PUTC(&c, '\0');
+    w->stack = c.stack;
+    w->size = c.size;
+    return c.stack;
+}
+
+void Free(value* v) {
+    walk_stack w;
+    assert(v != NULL);
+    if (!HAS_CHILDREN(v)) {
+        free_node(v);
+        return;
+    }
+    walk_init(&w);
+    walk_push(&w, v);
+    while (w.top) {
+        /* 叶子就地释放, 遇到有子节点的容器则先下去; 子节点全部释放后再释放容器自己 */
+        walk_frame* f = &w.f[w.top - 1];
+        value* p = (value*)f->v, *e = nullptr;
+        size_t i = f->i, n = CHILD_COUNT(p);
+        int keys = p->type == EASYJson_OBJECT && !(p->flags & FLAG_KEYS_BORROWED);
+        for (; i < n; i++) {
+            e = (value*)CHILD(p, i);
+            if (keys)
+                free(p->u.o.m[i].k);
+            if (HAS_CHILDREN(e))
+                break;
+            free_node(e);
+        }
+        if (i < n) {
+            f->i = i + 1;
+            walk_push(&w, e);
+            continue;
+        }
+        free_node(p);
+        w.top--;
+    }
+    walk_release(&w);
+}
+
+type get_type(const value* v) {
+    assert(v != NULL);
+    return v->type;
+}
+
+int get_boolean(const value* v) {
+    assert(v != NULL && (v->type == EASYJson_TRUE || v->type == EASYJson_FALSE));
+    return v->type == EASYJson_TRUE;
+}
+
+void set_boolean(value* v, int b) {
+    Free(v);
+    v->type = b ? EASYJson_TRUE :  EASYJson_FALSE;
+}
+
+double get_number(const value* v) {
+    assert(v != NULL && v->type == EASYJson_NUMBER);
+    if (v->flags & FLAG_INT64)
+        return (double)v->u.i64;
+    if (v->flags & FLAG_UINT64)
+        return (double)v->u.u64;
+    return v->u.n;
+}
+
+void set_number(value* v, double n) {
+    Free(v);
+    v->u.n = n;
+    v->type = EASYJson_NUMBER;
+}
+
+int is_int64(const value* v) {
+    assert(v != NULL);
+    return v->type == EASYJson_NUMBER && (v->flags & FLAG_INT64);
+}
+
+int is_uint64(const value* v) {
+    assert(v != NULL);
+    return v->type == EASYJson_NUMBER && ((v->flags & FLAG_UINT64) || ((v->flags & FLAG_INT64) && v->u.i64 >= 0));
+}
+
+int64_t get_int64(const value* v) {
+    assert(is_int64(v));
+    return v->u.i64;
+}
+
+void set_int64(value* v, int64_t i) {
+    Free(v);
+    v->u.i64 = i;
+    v->type = EASYJson_NUMBER;
+    v->flags = FLAG_INT64;
+}
+
+uint64_t get_uint64(const value* v) {
+    assert(is_uint64(v));
+    return v->u.u64;
+}
+
+void set_uint64(value* v, uint64_t u) {
+    Free(v);
+    v->u.u64 = u;
+    v->type = EASYJson_NUMBER;
+    v->flags = u <= (uint64_t)INT64_MAX ? FLAG_INT64 : FLAG_UINT64;
+}
+
+const char* get_string(const value* v) {
+    assert(v != NULL && v->type == EASYJson_STRING);
+    return v->flags & FLAG_INLINE ? v->u.ss : v->u.s.s;
+}
+
+size_t get_string_length(const value* v) {
+    assert(v != NULL && v->type == EASYJson_STRING);
+    return v->flags & FLAG_INLINE ? (unsigned char)v->u.ss[sizeof(v->u.ss) - 1] : v->u.s.len;
+}
+
+void set_string(value* v, const char* s, size_t len) {
+    assert(v != NULL && (s != NULL || len == 0));
+    Free(v);
+    if (len <= INLINE_STRING_MAX) {
+        set_inline_string(v, s, len);
+        return;
+    }
+    v->u.s.s = (char*)malloc(len + 1);
+    memcpy(v->u.s.s, s, len);
+    v->u.s.s[len] = '\0';
+    v->u.s.len = len;
+    v->type = EASYJson_STRING; 
+}
+
+void set_array(value* v, size_t capacity) {
+    assert(v != NULL);
+    Free(v);
+    v->type = EASYJson_ARRAY;
+    v->u.a.size = 0;
+    v->u.a.capacity = capacity;
+    v->u.a.e = capacity > 0 ? (value*)malloc(capacity * sizeof(value)) : nullptr;
+}
+
+size_t get_array_size(const value* v) {
+    assert(v != NULL && v->type == EASYJson_ARRAY);
+    return v->u.a.size;
+}
+
+size_t get_array_capacity(const value* v) {
+    assert(v != NULL && v->type == EASYJson_ARRAY);
+    return v->u.a.capacity;
+}
+
+/* 把元素数组换成容量为 capacity 的堆内存; arena 中的数组复制出来 */
+static void resize_array(value* v, size_t capacity) {
+    value* e = v->u.a.e;
+    if (v->flags & FLAG_BORROWED) {
+        e = capacity > 0 ? (value*)malloc(capacity * sizeof(value)) : nullptr;
+        if (v->u.a.size)
+            memcpy(e, v->u.a.e, v->u.a.size * sizeof(value));
+        v->flags &= ~FLAG_BORROWED;
+    }
+    else if (capacity == 0) {
+        free(e);
+        e = nullptr;
+    }
+    else
+        e = (value*)realloc(e, capacity * sizeof(value));
+    v->u.a.e = e;
+    v->u.a.capacity = capacity;
+}
+
+void reserve_array(value* v, size_t capacity) {
+    assert(v != NULL && v->type == EASYJson_ARRAY);
+    if (v->u.a.capacity < capacity)
+        resize_array(v, capacity);
+}
+
+void shrink_array(value* v) {
+    assert(v != NULL && v->type == EASYJson_ARRAY);
+    if (v->u.a.capacity > v->u.a.size && !(v->flags & FLAG_BORROWED))
+        resize_array(v, v->u.a.size);
+}
+
+void clear_array(value* v) {
+    assert(v != NULL && v->type == EASYJson_ARRAY);
+    erase_array_element(v, 0, v->u.a.size);
+}
+
+value* get_array_element(const value* v, size_t index) {
+    assert(v != NULL && v->type == EASYJson_ARRAY);
+    assert(index < v->u.a.size);
+    return &v->u.a.e[index];
+}
+
+value* pushback_array_element(value* v) {
+    assert(v != NULL && v->type == EASYJson_ARRAY);
+    return insert_array_element(v, v->u.a.size);
+}
+
+void popback_array_element(value* v) {
+    assert(v != NULL && v->type == EASYJson_ARRAY && v->u.a.size > 0);
+    Free(&v->u.a.e[--v->u.a.size]);
+}
+
+value* insert_array_element(value* v, size_t index) {
+    value* e;
+    assert(v != NULL && v->type == EASYJson_ARRAY && index <= v->u.a.size);
+    if (v->u.a.size == v->u.a.capacity)
+        resize_array(v, v->u.a.capacity ? 2 * v->u.a.capacity : 4);
+    e = &v->u.a.e[index];
+    memmove(e + 1, e, (v->u.a.size++ - index) * sizeof(value));
+    init(e);
+    return e;
+}
+
+void erase_array_element(value* v, size_t index, size_t count) {
+    size_t i;
+    assert(v != NULL && v->type == EASYJson_ARRAY && index <= v->u.a.size && count <= v->u.a.size - index);
+    for (i = index; i < index + count; i++)
+        Free(&v->u.a.e[i]);
+    if (count) {
+        memmove(&v->u.a.e[index], &v->u.a.e[index + count], (v->u.a.size - index - count) * sizeof(value));
+        v->u.a.size -= count;
+    }
+}
+
+void set_object(value* v, size_t capacity) {
+    assert(v != NULL && capacity <= UINT32_MAX);
+    Free(v);
+    v->type = EASYJson_OBJECT;
+    v->u.o.size = 0;
+    v->u.o.capacity = (uint32_t)capacity;
+    v->u.o.m = capacity > 0 ? (member*)malloc(capacity * sizeof(member)) : nullptr;
+    v->u.o.index = nullptr;
+}
+
+size_t get_object_size(const value* v) {
+    assert(v != NULL && v->type == EASYJson_OBJECT);
+    return v->u.o.size;
+}
+
+size_t get_object_capacity(const value* v) {
+    assert(v != NULL && v->type == EASYJson_OBJECT);
+    return v->u.o.capacity;
+}
+
+const char* get_object_key(const value* v, size_t index) {
+    assert(v != nullptr && v->type == EASYJson_OBJECT);
+    assert(index < v->u.o.size);
+    return v->u.o.m[index].k;
+}
+
+size_t get_object_key_length(const value* v, size_t index) {
+    assert(v != nullptr && v->type == EASYJson_OBJECT);
+    assert(index < v->u.o.size);
+    return v->u.o.m[index].klen;
+}
+value* get_object_value(const value* v, size_t index) {
+    assert(v != nullptr && v->type == EASYJson_OBJECT);
+    assert(index < v->u.o.size);
+    return &(v->u.o.m[index].v);
+}
+
+/*
+开放寻址哈希索引: 槽中存成员下标 + 1 (0 为空), 线性探测, 装载因子不超过 1/2.
+按成员顺序插入, 因此探测时先遇到的就是第一个同名键.
+*/
+struct object_index
+{
+    const member* m;    /* 建立索引时的成员数组与大小, 与 u.o 不符即失效 */
+    size_t size;
+    size_t mask;
+    uint32_t* slots;
+};
+
+static object_index* build_object_index(const value* v) {
+    size_t i, j, cap = 2 * OBJECT_INDEX_THRESHOLD;
+    object_index* idx;
+    while (cap < 2 * v->u.o.size)
+        cap *= 2;
+    idx = (object_index*)malloc(sizeof(object_index) + cap * sizeof(uint32_t));
+    if (!idx)
+        return nullptr;
+    idx->m = v->u.o.m;
+    idx->size = v->u.o.size;
+    idx->mask = cap - 1;
+    idx->slots = (uint32_t*)(idx + 1);
+    memset(idx->slots, 0, cap * sizeof(uint32_t));
+    for (i = 0; i < v->u.o.size; i++) {
+        for (j = hash_key(v->u.o.m[i].k, v->u.o.m[i].klen) & idx->mask; idx->slots[j]; j = (j + 1) & idx->mask)
+            ;
+        idx->slots[j] = (uint32_t)(i + 1);
+    }
+    return idx;
+}
+
+static size_t scan_object(const value* v, const char* key, size_t klen) {
+    size_t i;
+    for (i = 0; i < v->u.o.size; i++)
+        if (v->u.o.m[i].klen == klen && memcmp(v->u.o.m[i].k, key, klen) == 0)
+            return i;
+    return KEY_NOT_EXIST;
+}
+
+static size_t probe_object_index(const object_index* idx, const value* v, const char* key, size_t klen, size_t hash) {
+    size_t i;
+    for (i = hash & idx->mask; idx->slots[i]; i = (i + 1) & idx->mask) {
+        const member* m = &v->u.o.m[idx->slots[i] - 1];
+        if (m->klen == klen && memcmp(m->k, key, klen) == 0)
+            return idx->slots[i] - 1;
+    }
+    return KEY_NOT_EXIST;
+}
+
+/* hash 非空时为预先算好的 hash_key(key, klen) */
+static size_t lookup_object(const value* v, const char* key, size_t klen, const size_t* hash) {
+    object_index* idx;
+    if (v->u.o.size < OBJECT_INDEX_THRESHOLD || v->u.o.size >= UINT32_MAX || (v->flags & FLAG_BORROWED))
+        return scan_object(v, key, klen);
+    idx = v->u.o.index;
+    if (!idx || idx->m != v->u.o.m || idx->size != v->u.o.size) {
+        /* 索引只是缓存, 不影响 v 的逻辑内容 */
+        free(idx);
+        idx = ((value*)v)->u.o.index = build_object_index(v);
+        if (!idx)
+            return scan_object(v, key, klen);
+    }
+    return probe_object_index(idx, v, key, klen, hash ? *hash : hash_key(key, klen));
+}
+
+size_t find_object_index(const value* v, const char* key, size_t klen) {
+    assert(v != nullptr && v->type == EASYJson_OBJECT && key != nullptr);
+    return lookup_object(v, key, klen, nullptr);
+}
+
+value* find_object_value(const value* v, const char* key, size_t klen) {
+    size_t i = find_object_index(v, key, klen);
+    return i != KEY_NOT_EXIST ? &v->u.o.m[i].v : nullptr;
+}
+
+void reset_object_index(value* v) {
+    assert(v != nullptr && v->type == EASYJson_OBJECT);
+    free(v->u.o.index);
+    v->u.o.index = nullptr;
+}
+
+/* 同 resize_array; 成员数组换了地址, 索引随之失效 */
+static void resize_object(value* v, size_t capacity) {
+    member* m = v->u.o.m;
+    if (v->flags & FLAG_BORROWED) {
+        m = capacity > 0 ? (member*)malloc(capacity * sizeof(member)) : nullptr;
+        if (v->u.o.size)
+            memcpy(m, v->u.o.m, v->u.o.size * sizeof(member));
+        v->flags &= ~FLAG_BORROWED;
+    }
+    else if (capacity == 0) {
+        free(m);
+        m = nullptr;
+    }
+    else
+        m = (member*)realloc(m, capacity * sizeof(member));
+    v->u.o.m = m;
+    v->u.o.capacity = (uint32_t)capacity;
+}
+
+void reserve_object(value* v, size_t capacity) {
+    assert(v != nullptr && v->type == EASYJson_OBJECT && capacity <= UINT32_MAX);
+    if (v->u.o.capacity < capacity)
+        resize_object(v, capacity);
+}
+
+void shrink_object(value* v) {
+    assert(v != nullptr && v->type == EASYJson_OBJECT);
+    if (v->u.o.capacity > v->u.o.size && !(v->flags & FLAG_BORROWED))
+        resize_object(v, v->u.o.size);
+}
+
+void clear_object(value* v) {
+    size_t i;
+    assert(v != nullptr && v->type == EASYJson_OBJECT);
+    for (i = 0; i < v->u.o.size; i++) {
+        if (!(v->flags & FLAG_KEYS_BORROWED))
+            free(v->u.o.m[i].k);
+        Free(&v->u.o.m[i].v);
+    }
+    v->u.o.size = 0;
+    reset_object_index(v);
+}
+
+value* set_object_value(value* v, const char* key, size_t klen) {
+    size_t i, j;
+    object_index* idx;
+    member* m;
+    assert(v != nullptr && v->type == EASYJson_OBJECT && key != nullptr);
+    if ((i = find_object_index(v, key, klen)) != KEY_NOT_EXIST)
+        return &v->u.o.m[i].v;
+    if (v->flags & FLAG_KEYS_BORROWED) {
+        /* 键与其他成员的键同样归对象所有, Free 才能统一释放 */
+        for (i = 0; i < v->u.o.size; i++)
+            v->u.o.m[i].k = (char*)memcpy(malloc(v->u.o.m[i].klen + 1), v->u.o.m[i].k, v->u.o.m[i].klen + 1);
+        v->flags &= ~FLAG_KEYS_BORROWED;
+    }
+    /* 成员多时上面的查找已建好索引 */
+    idx = v->u.o.index;
+    if (idx && (idx->m != v->u.o.m || idx->size != v->u.o.size))
+        idx = nullptr;
+    assert(v->u.o.size < UINT32_MAX);
+    if (v->u.o.size == v->u.o.capacity)
+        resize_object(v, v->u.o.capacity ? (v->u.o.capacity < UINT32_MAX / 2 ? 2 * v->u.o.capacity : UINT32_MAX) : 4);
+    m = &v->u.o.m[v->u.o.size++];
+    m->k = (char*)malloc(klen + 1);
+    memcpy(m->k, key, klen);
+    m->k[klen] = '\0';
+    m->klen = klen;
+    init(&m->v);
+    /* 索引的装载因子仍不超过 1/2 时把新成员加进去, 否则丢弃, 下次查找时按新的大小重建 */
+    if (idx && 2 * (size_t)v->u.o.size <= idx->mask + 1) {
+        for (j = hash_key(key, klen) & idx->mask; idx->slots[j]; j = (j + 1) & idx->mask)
+            ;
+        idx->slots[j] = v->u.o.size;
+        idx->m = v->u.o.m;
+        idx->size = v->u.o.size;
+    }
+    else
+        reset_object_index(v);
+    return &m->v;
+}
+
+void remove_object_value(value* v, size_t index) {
+    assert(v != nullptr && v->type == EASYJson_OBJECT && index < v->u.o.size);
+    if (!(v->flags & FLAG_KEYS_BORROWED))
+        free(v->u.o.m[index].k);
+    Free(&v->u.o.m[index].v);
+    memmove(&v->u.o.m[index], &v->u.o.m[index + 1], (v->u.o.size - index - 1) * sizeof(member));
+    v->u.o.size--;
+    reset_object_index(v);
+}
+
+int compile_pointer(pointer* p, const char* s, size_t len) {
+    size_t i, n = 0;
+    pointer_token* t;
+    char* k;
+    assert(p != nullptr && (s != nullptr || len == 0));
+    p->tokens = nullptr;
+    p->count = 0;
+    if (len == 0)
+        return POINTER_OK;
+    if (s[0] != '/')
+        return POINTER_INVALID_SYNTAX;
+    for (i = 0; i < len; i++) {
+        if (s[i] == '/')
+            n++;
+        else if (s[i] == '~' && (i + 1 == len || (s[i + 1] != '0' && s[i + 1] != '1')))
+            return POINTER_INVALID_SYNTAX;
+    }
+    /* 记号数组之后依次存放各记号, 解开转义只会变短; 每个记号另加 '\0' */
+    t = (pointer_token*)malloc(n * sizeof(pointer_token) + len + n);
+    k = (char*)(t + n);
+    for (i = 0, n = 0; i < len; n++) {
+        pointer_token* tok = &t[n];
+        size_t j;
+        tok->key = k;
+        for (i++; i < len && s[i] != '/'; i++) {
+            if (s[i] == '~')
+                *k++ = s[++i] == '0' ? '~' : '/';
+            else
+                *k++ = s[i];
+        }
+        tok->len = k - tok->key;
+        *k++ = '\0';
+        tok->hash = hash_key(tok->key, tok->len);
+        /* 下标为 "0" 或不以 0 开头的数字串 */
+        tok->index = POINTER_NO_INDEX;
+        if (tok->len == 1 && tok->key[0] == '-')
+            tok->index = POINTER_END;
+        else if (tok->len > 0 && tok->len < 20 && (tok->key[0] != '0' || tok->len == 1)) {
+            for (j = 0, tok->index = 0; j < tok->len && ISDIGIT(tok->key[j]); j++)
+                tok->index = tok->index * 10 + (tok->key[j] - '0');
+            if (j < tok->len)
+                tok->index = POINTER_NO_INDEX;
+        }
+    }
+    p->tokens = t;
+    p->count = n;
+    return POINTER_OK;
+}
+
+void pointer_release(pointer* p) {
+    assert(p != nullptr);
+    free(p->tokens);
+    p->tokens = nullptr;
+    p->count = 0;
+}
+
+static value* pointer_step(const value* v, const pointer_token* t) {
+    size_t i;
+    switch (v->type)
+    {
+    case EASYJson_OBJECT:
+        i = lookup_object(v, t->key, t->len, &t->hash);
+        return i != KEY_NOT_EXIST ? &v->u.o.m[i].v : nullptr;
+    case EASYJson_ARRAY:
+        return t->index < v->u.a.size ? &v->u.a.e[t->index] : nullptr;
+    default:
+        return nullptr;
+    }
+}
+
+value* get_by_pointer(const value* v, const pointer* p) {
+    size_t i;
+    assert(v != nullptr && p != nullptr);
+    for (i = 0; i < p->count && v; i++)
+        v = pointer_step(v, &p->tokens[i]);
+    return (value*)v;
+}
+
+value* get_by_pointer(const value* v, const char* s, size_t len) {
+    pointer p;
+    value* r;
+    if (compile_pointer(&p, s, len) != POINTER_OK)
+        return nullptr;
+    r = get_by_pointer(v, &p);
+    pointer_release(&p);
+    return r;
+}
+
+int set_by_pointer(value* root, const pointer* p, value* v) {
+    const pointer_token* last;
+    value *parent = root, *target, temp;
+    size_t i;
+    assert(root != nullptr && p != nullptr && v != nullptr);
+    for (i = 0; i + 1 < p->count && parent; i++) {
+        assert(parent != v);    /* 不能移入自己的子树 */
+        parent = pointer_step(parent, &p->tokens[i]);
+    }
+    if (!parent)
+        return POINTER_NOT_FOUND;
+    assert(p->count == 0 || parent != v);
+    if (p->count && parent->type != EASYJson_ARRAY && parent->type != EASYJson_OBJECT)
+        return POINTER_NOT_FOUND;
+    /* 先取出 *v: v 可能在目标之下, 或是追加时会被搬走的兄弟元素 */
+    memcpy(&temp, v, sizeof(value));
+    init(v);
+    if (p->count == 0)
+        target = root;
+    else {
+        last = &p->tokens[p->count - 1];
+        if (!(target = pointer_step(parent, last))) {
+            if (parent->type == EASYJson_ARRAY) {
+                if (last->index != POINTER_END && last->index != parent->u.a.size) {
+                    memcpy(v, &temp, sizeof(value));    /* 失败时 *v 不变 */
+                    return POINTER_NOT_FOUND;
+                }
+                target = pushback_array_element(parent);
+            }
+            else
+                target = set_object_value(parent, last->key, last->len);
+        }
+    }
+    Free(target);
+    memcpy(target, &temp, sizeof(value));
+    return POINTER_OK;
+}
+
+int set_by_pointer(value* root, const char* s, size_t len, value* v) {
+    pointer p;
+    int ret;
+    if ((ret = compile_pointer(&p, s, len)) != POINTER_OK)
+        return ret;
+    ret = set_by_pointer(root, &p, v);
+    pointer_release(&p);
+    return ret;
+}
+
+/* v 是浅复制来的节点: 为它的字符串/元素/成员/键分配自己的副本, 子节点仍是浅复制 */
+static void detach_node(value* v) {
+    size_t i, n;
+    member* m;
+    switch (v->type)
+    {
+    case EASYJson_STRING:
+        if (!(v->flags & FLAG_INLINE)) {
+            const char* s = v->u.s.s;
+            if ((n = v->u.s.len) <= INLINE_STRING_MAX)
+                set_inline_string(v, s, n);
+            else
+                memcpy(v->u.s.s = (char*)malloc(n + 1), s, n + 1);
+        }
+        break;
+    case EASYJson_ARRAY:
+        n = v->u.a.size * sizeof(value);
+        v->u.a.e = n ? (value*)memcpy(malloc(n), v->u.a.e, n) : nullptr;
+        v->u.a.capacity = v->u.a.size;
+        break;
+    case EASYJson_OBJECT:
+        n = v->u.o.size * sizeof(member);
+        m = n ? (member*)memcpy(malloc(n), v->u.o.m, n) : nullptr;
+        for (i = 0; i < v->u.o.size; i++)
+            memcpy(m[i].k = (char*)malloc(m[i].klen + 1), v->u.o.m[i].k, m[i].klen + 1);
+        v->u.o.m = m;
+        v->u.o.capacity = v->u.o.size;
+        v->u.o.index = nullptr;
+        break;
+    default:
+        break;
+    }
+    v->flags &= FLAG_INT64 | FLAG_UINT64 | FLAG_INLINE;
+}
+
+void copy(value* dst, const value* src) {
+    walk_stack w;
+    value t;
+    assert(dst != nullptr && src != nullptr);
+    if (dst == src)
+        return;
+    /* 先复制到 t 再释放 dst, src 可以是 dst 的子节点 */
+    memcpy(&t, src, sizeof(value));
+    detach_node(&t);
+    /* 先序遍历副本: 每个节点在父节点的副本中浅复制得到, 经 detach_node 后再下去 */
+    walk_init(&w);
+    if (HAS_CHILDREN(&t))
+        walk_push(&w, &t);
+    while (w.top) {
+        walk_frame* f = &w.f[w.top - 1];
+        value* p = (value*)f->v, *e = nullptr;
+        size_t i = f->i, n = CHILD_COUNT(p);
+        for (; i < n; i++) {
+            detach_node(e = (value*)CHILD(p, i));
+            if (HAS_CHILDREN(e))
+                break;
+        }
+        if (i < n) {
+            f->i = i + 1;
+            walk_push(&w, e);
+            continue;
+        }
+        w.top--;
+    }
+    walk_release(&w);
+    Free(dst);
+    memcpy(dst, &t, sizeof(value));
+}
+
+void move(value* dst, value* src) {
+    value t;
+    assert(dst != nullptr && src != nullptr);
+    if (dst == src)
+        return;
+    memcpy(&t, src, sizeof(value));
+    init(src);
+    Free(dst);
+    memcpy(dst, &t, sizeof(value));
+}
+
+void swap(value* a, value* b) {
+    value t;
+    assert(a != nullptr && b != nullptr);
+    memcpy(&t, a, sizeof(value));
+    memcpy(a, b, sizeof(value));
+    memcpy(b, &t, sizeof(value));
+}
+
+/* 整数与 double 比较时要求 double 恰好是该整数 */
+static int number_equal(const value* a, const value* b) {
+    const unsigned ints = FLAG_INT64 | FLAG_UINT64;
+    const value* d;
+    if ((a->flags & ints) == (b->flags & ints))
+        return a->flags & ints ? a->u.u64 == b->u.u64 : a->u.n == b->u.n;
+    if ((a->flags & ints) && (b->flags & ints))
+        return 0;   /* int64 与大于 INT64_MAX 的 uint64 */
+    d = a->flags & ints ? b : a;
+    if (d == a)
+        a = b;
+    if (d->u.n != floor(d->u.n))
+        return 0;   /* 带小数部分的 double 不等于任何整数 */
+    if (a->flags & FLAG_INT64)
+        return d->u.n >= -9223372036854775808.0 && d->u.n < 9223372036854775808.0 && (int64_t)d->u.n == a->u.i64;
+    return d->u.n >= 0 && d->u.n < 18446744073709551616.0 && (uint64_t)d->u.n == a->u.u64;
+}
+
+/* 类型相同且标量的值相同; 容器只比较大小 */
+static int node_equal(const value* a, const value* b) {
+    if (a->type != b->type)
+        return 0;
+    switch (a->type)
+    {
+    case EASYJson_NUMBER:
+        return number_equal(a, b);
+    case EASYJson_STRING:
+        return get_string_length(a) == get_string_length(b) && memcmp(get_string(a), get_string(b), get_string_length(a)) == 0;
+    case EASYJson_ARRAY:
+    case EASYJson_OBJECT:
+        return CHILD_COUNT(a) == CHILD_COUNT(b);
+    default:
+        return 1;
+    }
+}
 
-    m.k = nullptr;
-    size = 0;
-    for (;;) {
-        char* str;
-        init(&m.v);
-        /* \todo parse key to m.k, m.klen */
-        if (*c->json != '"') {
-            ret = PARSE_MISS_KEY;
-            break;
+struct equal_frame
+{
+    const value* a;
+    const value* b;
+    size_t i;
+    object_index* tmp;  /* b 在 arena 中时临时建立的索引 */
+};
+
+/* a 的第 i 个成员在 b 中对应的值: 先看同一位置, 顺序不同再按键查找 */
+static const value* equal_member(equal_frame* f) {
+    const member* m = &f->a->u.o.m[f->i];
+    const value* b = f->b;
+    size_t j;
+    if (b->u.o.m[f->i].klen == m->klen && memcmp(b->u.o.m[f->i].k, m->k, m->klen) == 0)
+        return &b->u.o.m[f->i].v;
+    if ((b->flags & FLAG_BORROWED) && b->u.o.size >= OBJECT_INDEX_THRESHOLD && b->u.o.size < UINT32_MAX) {
+        if (!f->tmp)
+            f->tmp = build_object_index(b);
+        j = f->tmp ? probe_object_index(f->tmp, b, m->k, m->klen, hash_key(m->k, m->klen)) : scan_object(b, m->k, m->klen);
+    }
+    else
+        j = lookup_object(b, m->k, m->klen, nullptr);
+    return j != KEY_NOT_EXIST ? &b->u.o.m[j].v : nullptr;
+}
+
+int is_equal(const value* a, const value* b) {
+    equal_frame local[WALK_LOCAL_SIZE], *f = local;
+    size_t top = 0, cap = WALK_LOCAL_SIZE;
+    int equal;
+    assert(a != nullptr && b != nullptr);
+    if (!node_equal(a, b))
+        return 0;
+    if (!HAS_CHILDREN(a))
+        return 1;
+    f[top++] = { a, b, 0, nullptr };
+    for (equal = 1; equal && top; ) {
+        equal_frame* t = &f[top - 1];
+        const value *ca, *cb;
+        if (t->i == CHILD_COUNT(t->a)) {
+            free(t->tmp);
+            top--;
+            continue;
         }
-        if ((ret = parse_string_raw(c, &str, &m.klen)) != PARSE_OK) {
-            break;
+        ca = CHILD(t->a, t->i);
+        cb = t->a->type == EASYJson_ARRAY ? &t->b->u.a.e[t->i] : equal_member(t);
+        t->i++;
+        if (!cb || !node_equal(ca, cb))
+            equal = 0;
+        else if (HAS_CHILDREN(ca)) {
+            if (top == cap) {
+                equal_frame* g = (equal_frame*)malloc(sizeof(equal_frame) * (cap *= 2));
+                memcpy(g, f, sizeof(equal_frame) * top);
+                if (f != local)
+                    free(f);
+                f = g;
+            }
+            f[top++] = { ca, cb, 0, nullptr };
         }
-        memcpy(m.k = (char*)malloc(m.klen + 1), str, m.klen);
-        m.k[m.klen] = '\0';
+    }
+    while (top)
+        free(f[--top].tmp);
+    if (f != local)
+        free(f);
+    return equal;
+}
 
-        parse_whitespace(c);
-        /* \todo parse ws colon ws */
-        if (*c->json != ':') {
-            ret = PARSE_MISS_COLON;
-            break;
+/*
+按需解析: 只在取值时解码. 跳过未访问的值时, 字符串只找结尾引号, 数组/对象只数括号,
+不检查其中的语法
+*/
+struct bracket_masks
+{
+    uint64_t open, close, quote, backslash, control;
+};
+
+/* 64 字节块中括号、引号、反斜杠与控制字符的位置 */
+#ifdef EASYJSON_SSE2
+static inline void classify_brackets(const char* p, bracket_masks* m) {
+    const __m128i lcurly = _mm_set1_epi8('{'), rcurly = _mm_set1_epi8('}'), lower = _mm_set1_epi8(0x20);
+    const __m128i quote = _mm_set1_epi8('"'), slash = _mm_set1_epi8('\\'), ctrl = _mm_set1_epi8(0x1F);
+    int i;
+    m->open = m->close = m->quote = m->backslash = m->control = 0;
+    for (i = 0; i < 4; i++) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(p + 16 * i));
+        __m128i y = _mm_or_si128(x, lower);     /* '[' ']' 变为 '{' '}' */
+        m->open |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(y, lcurly)) << (16 * i);
+        m->close |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(y, rcurly)) << (16 * i);
+        m->quote |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, quote)) << (16 * i);
+        m->backslash |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, slash)) << (16 * i);
+        m->control |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(x, ctrl), x)) << (16 * i);
+    }
+}
+#else
+static inline void classify_brackets(const char* p, bracket_masks* m) {
+    int i;
+    m->open = m->close = m->quote = m->backslash = m->control = 0;
+    for (i = 0; i < 64; i++) {
+        uint64_t bit = (uint64_t)1 << i;
+        switch (p[i])
+        {
+        case '[': case '{': m->open |= bit; break;
+        case ']': case '}': m->close |= bit; break;
+        case '"': m->quote |= bit; break;
+        case '\\': m->backslash |= bit; break;
+        default:
+            if ((unsigned char)p[i] < 0x20)
+                m->control |= bit;
         }
-        c->json++;
-        parse_whitespace(c);
-        /* parse value */
-        if ((ret = parse_value(c, &m.v)) != PARSE_OK)
-            break;
-        memcpy(context_push(c, sizeof(member)), &m, sizeof(member));
-        size++;
-        m.k = nullptr; /* ownership is transferred to member on stack */
-        /* \todo parse ws [comma | right-curly-brace] ws */
-        parse_whitespace(c);
-        if (*c->json == ',') {
-            c->json++;
-            parse_whitespace(c);
+    }
+}
+#endif
+
+/*
+跳过 *pp 处的数组/对象: 按块求出字符串外的括号, 一般只按个数累计层数,
+只有本块的右括号数不少于当前层数 (可能在本块内闭合) 时才逐个走
+*/
+static int lazy_skip_container(const char** pp, const char* end) {
+    const char* p = *pp;
+    char buf[64];
+    uint64_t escaped = 0, in_string = 0;
+    size_t depth = 0;
+    int miss = *p == '[' ? PARSE_MISS_COMMA_OR_SQUARE_BRACKET : PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+    for (; p < end; p += 64) {
+        bracket_masks m;
+        uint64_t inside, open, close, all;
+        classify_brackets(index_load(p, end, buf), &m);
+        inside = prefix_xor(block_quotes(m.quote, m.backslash, &escaped)) ^ in_string;
+        in_string = (uint64_t)((int64_t)inside >> 63);
+        open = m.open & ~inside;
+        close = m.close & ~inside;
+        if (POPCOUNT64(close) < depth) {
+            if (m.control & inside)
+                return PARSE_INVALID_STRING_CHAR;
+            depth = depth + POPCOUNT64(open) - POPCOUNT64(close);
+            continue;
         }
-        else if (*c->json == '}') {
-            size_t s = sizeof(member) * size;
-            c->json++;
-            v->type = EASYJson_OBJECT;
-            v->u.o.size = size;
-            memcpy(v->u.o.m = (member*)malloc(s), context_pop(c, s), s);
-            return PARSE_OK;
+        for (all = open | close; all; all &= all - 1) {
+            unsigned i = CTZ64(all);
+            if (open >> i & 1)
+                depth++;
+            else if (--depth == 0) {
+                if (m.control & inside & (((uint64_t)2 << i) - 1))
+                    return PARSE_INVALID_STRING_CHAR;
+                if ((p[i] ^ **pp) != ('[' ^ ']'))    /* 只核对最外层的括号种类 */
+                    return miss;
+                *pp = p + i + 1;
+                return PARSE_OK;
+            }
         }
-        else {
-            ret = PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+        if (m.control & inside)
+            return PARSE_INVALID_STRING_CHAR;
+    }
+    return in_string ? PARSE_MISS_QUOTATION_MARK : miss;
+}
+
+static int lazy_skip(const char** pp, const char* end) {
+    const char* p = *pp;
+    if (p == end || *p == ',' || *p == ']' || *p == '}')
+        return PARSE_EXPECT_VALUE;
+    if (*p == '[' || *p == '{')
+        return lazy_skip_container(pp, end);
+    if (*p != '"') {
+        /* 标量的内容由 get_value 校验 */
+        while (p != end && !ISWHITESPACE(*p) && *p != ',' && *p != ']' && *p != '}')
+            p++;
+        *pp = p;
+        return PARSE_OK;
+    }
+    for (p++;;) {
+        p = scan_string(p, end);
+        if (p == end)
+            return PARSE_MISS_QUOTATION_MARK;
+        if (*p == '"')
             break;
-        }
+        if (*p != '\\')
+            return PARSE_INVALID_STRING_CHAR;
+        if (end - p < 2)
+            return PARSE_MISS_QUOTATION_MARK;
+        p += 2;
     }
-    /* \todo Pop and free members on the stack */
-    free(m.k);
-    for (i = 0; i < size; i++) {
-        member* m = (member*)context_pop(c, sizeof(member));
-        free(m->k);
-        Free(&m->v);
+    *pp = p + 1;
+    return PARSE_OK;
+}
+
+int parse_lazy(lazy* v, const char* json, size_t len) {
+    context c;
+    int ret;
+    assert(v != nullptr && (json != nullptr || len == 0));
+    context_init(&c, json, len);
+    parse_whitespace(&c);
+    v->json = c.json;
+    v->end = c.end;
+    v->next = nullptr;
+    if ((ret = lazy_skip(&c.json, c.end)) == PARSE_OK) {
+        parse_whitespace(&c);
+        if (c.json != c.end)
+            ret = PARSE_ROOT_NOT_SINGULAR;
     }
-    v->type = EASYJson_NULL;
+    if (ret != PARSE_OK)
+        v->json = nullptr;
     return ret;
 }
 
-static int parse_value(context* c, value* v) {
-    switch (*c->json)
+type get_type(const lazy* v) {
+    assert(v != nullptr && v->json != nullptr && v->json != v->end);
+    switch (*v->json)
     {
-    case 'n':
-        return parse_literal(c, v, "null", EASYJson_NULL);
-    case 't':
-        return parse_literal(c, v, "true", EASYJson_TRUE);
-    case 'f':
-        return parse_literal(c, v, "false", EASYJson_FALSE);
-    default:
-        return parse_number(c, v);
-    case '"':
-        return parse_string(c, v);
-    case '[':
-        return parse_array(c, v);
-    case '{':
-        return parse_object(c, v);
-    case '\0':
-        return PARSE_EXPECT_VALUE;
+    case 'n': return EASYJson_NULL;
+    case 't': return EASYJson_TRUE;
+    case 'f': return EASYJson_FALSE;
+    case '"': return EASYJson_STRING;
+    case '[': return EASYJson_ARRAY;
+    case '{': return EASYJson_OBJECT;
+    default: return EASYJson_NUMBER;
     }
 }
 
-int parse(EasyJson::value* v, const char* json) {
+/* 一个值之后: ws 之后是 ',' (返回 1) 或 close (返回 0) */
+static int lazy_next(context* c, char close, int* ret) {
+    parse_whitespace(c);
+    if (PEEK(c) == ',') {
+        c->json++;
+        parse_whitespace(c);
+        return 1;
+    }
+    if (PEEK(c) != close)
+        *ret = close == ']' ? PARSE_MISS_COMMA_OR_SQUARE_BRACKET : PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+    return 0;
+}
+
+int get_array_element(const lazy* v, size_t index, lazy* out) {
     context c;
-    assert(v != NULL);
-    int ret;
+    int ret = PARSE_OK;
+    assert(get_type(v) == EASYJson_ARRAY && out != nullptr);
+    context_init(&c, v->json + 1, v->end - v->json - 1);
+    out->json = out->next = nullptr;
+    out->end = v->end;
+    parse_whitespace(&c);
+    if (PEEK(&c) == ']')
+        return PARSE_OK;
+    for (;;) {
+        if (index-- == 0) {
+            if (c.json == c.end || *c.json == ',' || *c.json == ']' || *c.json == '}')
+                return PARSE_EXPECT_VALUE;
+            out->json = c.json;
+            return PARSE_OK;
+        }
+        if ((ret = lazy_skip(&c.json, c.end)) != PARSE_OK || !lazy_next(&c, ']', &ret))
+            return ret;
+    }
+}
 
-    c.json = json;
-    c.stack = NULL;
-    c.size = c.top = 0;
-    init(v);
+/* 从 c->json 处的成员起找 key, 到对象结尾或 stop 处为止; 找到时 *at 为该成员的位置, c->json 指向值 */
+static int lazy_find_member(context* c, const char* stop, const char* key, size_t klen, const char** at) {
+    const char* member;
+    char* k;
+    size_t len;
+    int ret = PARSE_OK, match;
+    for (;;) {
+        if ((member = c->json) == stop)
+            return PARSE_OK;
+        if (PEEK(c) != '"')
+            return PARSE_MISS_KEY;
+        /* 不含转义的键直接指向输入, 只有含转义的键经过栈 */
+        if ((ret = parse_string_raw(c, &k, &len)) != PARSE_OK)
+            return ret;
+        match = len == klen && memcmp(k, key, klen) == 0;
+        c->top = 0;
+        parse_whitespace(c);
+        if (PEEK(c) != ':')
+            return PARSE_MISS_COLON;
+        c->json++;
+        parse_whitespace(c);
+        if (match) {
+            if (c->json == c->end || *c->json == ',' || *c->json == ']' || *c->json == '}')
+                return PARSE_EXPECT_VALUE;
+            *at = member;
+            return PARSE_OK;
+        }
+        if ((ret = lazy_skip(&c->json, c->end)) != PARSE_OK || !lazy_next(c, '}', &ret))
+            return ret;
+    }
+}
+
+int find_object_value(lazy* v, const char* key, size_t klen, lazy* out) {
+    context c;
+    const char *begin, *at = nullptr;
+    int ret = PARSE_OK;
+    assert(get_type(v) == EASYJson_OBJECT && out != nullptr && key != nullptr);
+    context_init(&c, v->json + 1, v->end - v->json - 1);
+    out->json = out->next = nullptr;
+    out->end = v->end;
     parse_whitespace(&c);
+    if (PEEK(&c) != '}') {
+        begin = c.json;
+        if (v->next != nullptr)
+            c.json = v->next;
+        /* 先找到对象结尾, 没找到再从第一个成员找到起点为止 */
+        ret = lazy_find_member(&c, nullptr, key, klen, &at);
+        if (ret == PARSE_OK && at == nullptr && v->next != nullptr && v->next != begin) {
+            c.json = begin;
+            ret = lazy_find_member(&c, v->next, key, klen, &at);
+        }
+        if (at != nullptr) {
+            out->json = c.json;
+            v->next = at;
+        }
+    }
+    free(c.stack);
+    return ret;
+}
 
-    if ((ret = parse_value(&c, v)) == PARSE_OK) {
-        parse_whitespace(&c);
-        if (*c.json != '\0') {
-            v->type = EASYJson_NULL;
-            ret = PARSE_ROOT_NOT_SINGULAR;
+int get_value(const lazy* v, value* out) {
+    context c;
+    dom_handler h = { &c };
+    int ret;
+    assert(v != nullptr && v->json != nullptr && out != nullptr);
+    init(out);
+    context_init(&c, v->json, v->end - v->json);
+    if ((ret = parse_value(&c, h)) == PARSE_OK) {
+        memcpy(out, context_pop(&c, sizeof(value)), sizeof(value));
+        /* 标量之后须是分隔符, 如 [1x] */
+        if (c.json != c.end && !ISWHITESPACE(*c.json) && *c.json != ',' && *c.json != ']' && *c.json != '}') {
+            Free(out);
+            ret = PARSE_INVALID_VALUE;
         }
     }
-    assert(c.top == 0);
     free(c.stack);
     return ret;
 }
 
-#ifndef PARSE_STRINGIFY_INIT_SIZE
-#define PARSE_STRINGIFY_INIT_SIZE 256
+/*
+tape: 每个字的高 8 位为标签, 低 56 位为附加数据
+    'n' 't' 'f'             一个字
+    'l' 'u' 'd' 数字         两个字, 第二个字为 int64/uint64/double 的位
+    '"' 字符串               两个字, 附加数据为在 strings 中的偏移, 第二个字为长度; strings 中以 '\0' 结尾
+    '[' '{' 数组/对象         两个字, 附加数据为下一个兄弟的下标, 第二个字为元素/成员数, 其后是子节点
+*/
+#define TAPE_WORD(tag, payload) ((uint64_t)(tag) << 56 | (payload))
+#define TAPE_TAG(d, n) ((char)((d)->words[n] >> 56))
+#define TAPE_PAYLOAD(d, n) ((size_t)((d)->words[n] & (((uint64_t)1 << 56) - 1)))
+
+#ifndef TAPE_INIT_SIZE
+#define TAPE_INIT_SIZE 64
 #endif
 
-static void stringify_string(context* c, const char* s, size_t len) {
-    static const char hex_digits[] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
-    size_t i, size;
-    char* head, *p;
-    assert(s != nullptr);
-    p = head = (char*)context_push(c, size = len * 6 + 2); /* "\u00xx..." */
-    *p++ = '"';
-    for (i = 0; i < len; i++) {
-        unsigned char ch = (unsigned char)s[i];
-        switch (ch) {
-            case '\"': *p++ = '\\'; *p++ = '\"'; break;
-            case '\\': *p++ = '\\'; *p++ = '\\'; break;
-            case '\b': *p++ = '\\'; *p++ = 'b';  break;
-            case '\f': *p++ = '\\'; *p++ = 'f';  break;
-            case '\n': *p++ = '\\'; *p++ = 'n';  break;
-            case '\r': *p++ = '\\'; *p++ = 'r';  break;
-            case '\t': *p++ = '\\'; *p++ = 't';  break;
-            default:
-                if (ch < 0x20) {
-                    *p++ = '\\'; *p++ = 'u'; *p++ = '0'; *p++ = '0';
-                    *p++ = hex_digits[ch >> 4];
-                    *p++ = hex_digits[ch & 15];
-                }
-                else
-                    *p++ = s[i];
+/* 按事件顺序直接写 tape; 未结束的数组/对象头的位置记在 open 中, 结束时回填 */
+struct tape_handler
+{
+    tape* d;
+    size_t cap, scap;
+    size_t* open;
+    size_t depth, open_cap;
+
+    uint64_t* push(size_t n) {
+        if (d->size + n > cap) {
+            while (d->size + n > cap)
+                cap += cap >> 1;
+            d->words = (uint64_t*)realloc(d->words, cap * sizeof(uint64_t));
         }
+        d->size += n;
+        return d->words + d->size - n;
     }
-    *p++ = '"';
-    c->top -= size - (p - head);
+    int null() {
+        *push(1) = TAPE_WORD('n', 0);
+        return 1;
+    }
+    int boolean(int b) {
+        *push(1) = TAPE_WORD(b ? 't' : 'f', 0);
+        return 1;
+    }
+    int number(const value* n) {
+        uint64_t* w = push(2);
+        w[0] = TAPE_WORD((n->flags & FLAG_INT64) ? 'l' : (n->flags & FLAG_UINT64) ? 'u' : 'd', 0);
+        memcpy(&w[1], &n->u, sizeof(uint64_t));
+        return 1;
+    }
+    int string(const char* s, size_t len) {
+        uint64_t* w = push(2);
+        if (d->strings_size + len + 1 > scap) {
+            while (d->strings_size + len + 1 > scap)
+                scap += scap >> 1;
+            d->strings = (char*)realloc(d->strings, scap);
+        }
+        memcpy(d->strings + d->strings_size, s, len);
+        d->strings[d->strings_size + len] = '\0';
+        w[0] = TAPE_WORD('"', d->strings_size);
+        w[1] = len;
+        d->strings_size += len + 1;
+        return 1;
+    }
+    int start(char tag) {
+        if (depth == open_cap) {
+            open_cap = open_cap ? open_cap * 2 : 16;
+            open = (size_t*)realloc(open, open_cap * sizeof(size_t));
+        }
+        open[depth++] = d->size;
+        *push(2) = TAPE_WORD(tag, 0);
+        return 1;
+    }
+    int end(size_t size) {
+        size_t at = open[--depth];
+        d->words[at] |= d->size;
+        d->words[at + 1] = size;
+        return 1;
+    }
+    int start_array() { return start('['); }
+    int end_array(size_t size) { return end(size); }
+    int start_object() { return start('{'); }
+    int key(const char* s, size_t len) { return string(s, len); }
+    int end_object(size_t size) { return end(size); }
+    void discard_array(size_t) {}
+    void discard_object(size_t, int) {}
+};
+
+int parse_tape(tape* d, const char* json, size_t len) {
+    context c;
+    tape_handler h;
+    int ret;
+    assert(d != nullptr && (json != nullptr || len == 0));
+    h.d = d;
+    h.cap = len / 8 + TAPE_INIT_SIZE;
+    h.scap = len / 4 + TAPE_INIT_SIZE;
+    h.open = nullptr;
+    h.depth = h.open_cap = 0;
+    d->words = (uint64_t*)malloc(h.cap * sizeof(uint64_t));
+    d->strings = (char*)malloc(h.scap);
+    d->size = d->strings_size = 0;
+    context_init(&c, json, len);
+    parse_whitespace(&c);
+    if ((ret = parse_value(&c, h)) == PARSE_OK) {
+        parse_whitespace(&c);
+        if (c.json != c.end)
+            ret = PARSE_ROOT_NOT_SINGULAR;
+    }
+    free(c.stack);
+    free(h.open);
+    if (ret != PARSE_OK) {
+        tape_release(d);
+        return ret;
+    }
+    /* 只读文档, 按实际大小收缩 */
+    d->words = (uint64_t*)realloc(d->words, d->size * sizeof(uint64_t));
+    d->strings = (char*)realloc(d->strings, d->strings_size ? d->strings_size : 1);
+    return PARSE_OK;
 }
 
-static void stringify_value(context* c, const value* v) {
-    size_t i;
-    switch (v->type) {
-        case EASYJson_NULL:   PUTS(c, "null",  4); break;
-        case EASYJson_FALSE:  PUTS(c, "false", 5); break;
-        case EASYJson_TRUE:   PUTS(c, "true",  4); break;
-        case EASYJson_NUMBER: c->top -= 32 - sprintf((char *)context_push(c, 32), "%.17g", v->u.n); break;
-        case EASYJson_STRING: stringify_string(c, v->u.s.s, v->u.s.len); break;
-        case EASYJson_ARRAY:
-            PUTC(c, '[');
-            for (i = 0; i < v->u.a.size; i++) {
-                if (i > 0)
-                    PUTC(c, ',');
-                stringify_value(c, &v->u.a.e[i]);
-            }
-            PUTC(c, ']');
-            break;
-        case EASYJson_OBJECT:
-            PUTC(c, '{');
-            for (i = 0; i < v->u.o.size; i++) {
-                if (i > 0)
-                    PUTC(c, ',');
-                stringify_string(c, v->u.o.m[i].k, v->u.o.m[i].klen);
-                PUTC(c, ':');
-                stringify_value(c, &v->u.o.m[i].v);
-            }
-            PUTC(c, '}');
-            break;
-        default: assert(0 && "invalid type");
+void tape_release(tape* d) {
+    assert(d != nullptr);
+    free(d->words);
+    free(d->strings);
+    d->words = nullptr;
+    d->strings = nullptr;
+    d->size = d->strings_size = 0;
+}
+
+type get_type(const tape* d, size_t n) {
+    assert(d != nullptr && n < d->size);
+    switch (TAPE_TAG(d, n))
+    {
+    case 'n': return EASYJson_NULL;
+    case 't': return EASYJson_TRUE;
+    case 'f': return EASYJson_FALSE;
+    case '"': return EASYJson_STRING;
+    case '[': return EASYJson_ARRAY;
+    case '{': return EASYJson_OBJECT;
+    default: return EASYJson_NUMBER;
     }
 }
 
-char* stringify(const value* v, size_t* length) {
-    context c;
-    assert(v != nullptr);
-    c.stack = (char*)malloc(c.size = PARSE_STRINGIFY_INIT_SIZE);
-    c.top = 0;
-    stringify_value(&c, v);
-    if (length)
-        *length = c.top;
-    PUTC(&c, '\0');
-    return c.stack;
+int get_boolean(const tape* d, size_t n) {
+    assert(d != nullptr && (TAPE_TAG(d, n) == 't' || TAPE_TAG(d, n) == 'f'));
+    return TAPE_TAG(d, n) == 't';
 }
 
-void Free(value* v) {
-    size_t i;
-    assert(v != NULL);
-    switch (v->type)
+double get_number(const tape* d, size_t n) {
+    double x;
+    assert(d != nullptr && get_type(d, n) == EASYJson_NUMBER);
+    switch (TAPE_TAG(d, n))
     {
-    case EASYJson_STRING:
-        free(v->u.s.s);
-        break;
-    case EASYJson_ARRAY:
-        for (i = 0; i < v->u.a.size; i++) Free(&v->u.a.e[i]);
-        free(v->u.a.e);
-        break;
-    case EASYJson_OBJECT:
-        for (i = 0; i < v->u.o.size; i++) {
-            free(v->u.o.m[i].k);
-            Free(&v->u.o.m[i].v);
-        }
-        free(v->u.o.m);
-        break;
+    case 'l': return (double)(int64_t)d->words[n + 1];
+    case 'u': return (double)d->words[n + 1];
     default:
-        break;
+        memcpy(&x, &d->words[n + 1], sizeof(x));
+        return x;
     }
-    v->type = EASYJson_NULL;
 }
 
-type get_type(const value* v) {
-    assert(v != NULL);
-    return v->type;
+int is_int64(const tape* d, size_t n) {
+    assert(d != nullptr && n < d->size);
+    return TAPE_TAG(d, n) == 'l';
 }
 
-int get_boolean(const value* v) {
-    assert(v != NULL && (v->type == EASYJson_TRUE || v->type == EASYJson_FALSE));
-    return v->type == EASYJson_TRUE;
+int is_uint64(const tape* d, size_t n) {
+    assert(d != nullptr && n < d->size);
+    return TAPE_TAG(d, n) == 'u' || (TAPE_TAG(d, n) == 'l' && (int64_t)d->words[n + 1] >= 0);
 }
 
-void set_boolean(value* v, int b) {
-    Free(v);
-    v->type = b ? EASYJson_TRUE :  EASYJson_FALSE;
+int64_t get_int64(const tape* d, size_t n) {
+    assert(is_int64(d, n));
+    return (int64_t)d->words[n + 1];
 }
 
-double get_number(const value* v) {
-    assert(v != NULL && v->type == EASYJson_NUMBER);
-    return v->u.n;
+uint64_t get_uint64(const tape* d, size_t n) {
+    assert(is_uint64(d, n));
+    return d->words[n + 1];
 }
 
-void set_number(value* v, double n) {
-    Free(v);
-    v->u.n = n;
-    v->type = EASYJson_NUMBER;
+const char* get_string(const tape* d, size_t n) {
+    assert(d != nullptr && TAPE_TAG(d, n) == '"');
+    return d->strings + TAPE_PAYLOAD(d, n);
 }
 
-const char* get_string(const value* v) {
-    assert(v != NULL && v->type == EASYJson_STRING);
-    return v->u.s.s;
+size_t get_string_length(const tape* d, size_t n) {
+    assert(d != nullptr && TAPE_TAG(d, n) == '"');
+    return (size_t)d->words[n + 1];
 }
 
-size_t get_string_length(const value* v) {
-    assert(v != NULL && v->type == EASYJson_STRING);
-    return v->u.s.len;
+size_t first_child(const tape* d, size_t n) {
+    assert(d != nullptr && (TAPE_TAG(d, n) == '[' || TAPE_TAG(d, n) == '{'));
+    return n + 2;
 }
 
-void set_string(value* v, const char* s, size_t len) {
-    assert(v != NULL && (s != NULL || len == 0));
-    Free(v);
-    v->u.s.s = (char*)malloc(len + 1);
-    memcpy(v->u.s.s, s, len);
-    v->u.s.s[len] = '\0';
-    v->u.s.len = len;
-    v->type = EASYJson_STRING; 
+size_t next_sibling(const tape* d, size_t n) {
+    assert(d != nullptr && n < d->size);
+    switch (TAPE_TAG(d, n))
+    {
+    case 'n': case 't': case 'f': return n + 1;
+    case '[': case '{': return TAPE_PAYLOAD(d, n);
+    default: return n + 2;
+    }
 }
 
-size_t get_array_size(const value* v) {
-    assert(v != NULL && v->type == EASYJson_ARRAY);
-    return v->u.a.size;
+size_t get_array_size(const tape* d, size_t n) {
+    assert(d != nullptr && TAPE_TAG(d, n) == '[');
+    return (size_t)d->words[n + 1];
 }
 
-value* get_array_element(const value* v, size_t index) {
-    assert(v != NULL && v->type == EASYJson_ARRAY);
-    assert(index < v->u.a.size);
-    return &v->u.a.e[index];
+size_t get_array_element(const tape* d, size_t n, size_t index) {
+    size_t i;
+    assert(index < get_array_size(d, n));
+    for (i = first_child(d, n); index--; i = next_sibling(d, i))
+        ;
+    return i;
 }
 
-size_t get_object_size(const value* v) {
-    assert(v != NULL && v->type == EASYJson_OBJECT);
-    return v->u.o.size;
+size_t get_object_size(const tape* d, size_t n) {
+    assert(d != nullptr && TAPE_TAG(d, n) == '{');
+    return (size_t)d->words[n + 1];
 }
 
-const char* get_object_key(const value* v, size_t index) {
-    assert(v != nullptr && v->type == EASYJson_OBJECT);
-    assert(index < v->u.o.size);
-    return v->u.o.m[index].k;
+/* 第 index 个成员的键节点 */
+static size_t tape_member(const tape* d, size_t n, size_t index) {
+    size_t i;
+    assert(index < get_object_size(d, n));
+    for (i = first_child(d, n); index--; i = next_sibling(d, i + 2))
+        ;
+    return i;
 }
 
-size_t get_object_key_length(const value* v, size_t index) {
-    assert(v != nullptr && v->type == EASYJson_OBJECT);
-    assert(index < v->u.o.size);
-    return v->u.o.m[index].klen;
+const char* get_object_key(const tape* d, size_t n, size_t index) {
+    return get_string(d, tape_member(d, n, index));
+}
+
+size_t get_object_key_length(const tape* d, size_t n, size_t index) {
+    return get_string_length(d, tape_member(d, n, index));
+}
+
+size_t get_object_value(const tape* d, size_t n, size_t index) {
+    return tape_member(d, n, index) + 2;
+}
+
+size_t find_object_value(const tape* d, size_t n, const char* key, size_t klen) {
+    size_t i, end = next_sibling(d, n);
+    assert(d != nullptr && TAPE_TAG(d, n) == '{' && key != nullptr);
+    for (i = first_child(d, n); i != end; i = next_sibling(d, i + 2))
+        if (d->words[i + 1] == klen && memcmp(d->strings + TAPE_PAYLOAD(d, i), key, klen) == 0)
+            return i + 2;
+    return KEY_NOT_EXIST;
 }
-value* get_object_value(const value* v, size_t index) {
-    assert(v != nullptr && v->type == EASYJson_OBJECT);
-    assert(index < v->u.o.size);
-    return &(v->u.o.m[index].v);
 }
-}
\ No newline at end of file
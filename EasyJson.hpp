@@ -1,6 +1,19 @@
 #ifndef EASYJSON_H__
 #define EASYJSON_H__
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define EASYJSON_DOCUMENT   /* 启用 Document/Value 与 parse_into */
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif
 
 namespace EasyJson
 {
@@ -14,11 +27,22 @@ enum type {
     EASYJson_OBJECT
 };
 
+/* value::flags */
+enum flag {
+    FLAG_BORROWED      = 0x1,   /* u.s.s / u.a.e / u.o.m 不归本节点所有, Free 时不释放 */
+    FLAG_KEYS_BORROWED = 0x2,   /* 对象各成员的键不归本节点所有 */
+    FLAG_INT64         = 0x4,   /* 数字存于 u.i64 */
+    FLAG_UINT64        = 0x8,   /* 数字存于 u.u64 (大于 INT64_MAX) */
+    FLAG_INLINE        = 0x10   /* 短字符串直接存于 u.ss, 不另行分配 */
+};
+
 typedef struct value value;
 typedef struct member member;
+typedef struct object_index object_index;
 
 struct value{
     type type;
+    unsigned flags;
     union
     {
         // 字符串
@@ -27,20 +51,27 @@ struct value{
             char* s;
             size_t len;
         } s;
+        // 短字符串: 以 '\0' 结尾, 末字节存长度, 与 o 一样大
+        char ss[3 * sizeof(size_t)];
         // 数组
         struct 
         {
             value* e;
             size_t size;
+            size_t capacity;
         } a;
-        //对象
+        //对象: 成员数不超过 UINT32_MAX, 以便与索引一起放进 24 字节
         struct
         {
             member* m;
-            size_t size;
+            uint32_t size;
+            uint32_t capacity;
+            object_index* index;    /* find_object_value 按需建立的哈希索引 */
         }o;
         // 数字
         double n;
+        int64_t i64;
+        uint64_t u64;
     }u;    
 };
 
@@ -66,19 +97,154 @@ enum STATE {
     PARSE_MISS_COMMA_OR_SQUARE_BRACKET,
     PARSE_MISS_KEY,
     PARSE_MISS_COLON,
-    PARSE_MISS_COMMA_OR_CURLY_BRACKET
+    PARSE_MISS_COMMA_OR_CURLY_BRACKET,
+    PARSE_TERMINATED,           /* SAX 回调返回 0 中止了解析 */
+    PARSE_TOO_DEEP,             /* 嵌套超过 PARSE_MAX_DEPTH 层 */
+    PARSE_MISS_FIELD,           /* parse_into: 缺少必需的字段 */
+    PARSE_TYPE_MISMATCH         /* parse_into: 值的类型与字段不符, 或整数超出字段的范围 */
 };
 
-#define init(v) do { (v)->type = EASYJson_NULL; } while(0)
+/*
+内存池: 从大块内存中顺序分配, 整棵树随 arena_release 一次释放
+*/
+struct arena_chunk;
+struct arena
+{
+    char* cur;              /* 当前块的空闲区间 */
+    char* end;
+    arena_chunk* chunks;    /* 库自行分配的块 */
+    size_t chunk_size;      /* 下一个块的大小 */
+};
+
+#define init(v) do { (v)->type = EASYJson_NULL; (v)->flags = 0; } while(0)
+
+void arena_init(arena* a, void* buf, size_t size);
+void* arena_alloc(arena* a, size_t size);
+void arena_release(arena* a);
+
+/*
+键池: 每个不同的键只保存一份, 可在多个文档间共享. 设置 parser::keys 后解析出的 member::k
+都指向池中不可修改的副本, 同一个池中的键相同当且仅当指针相同.
+键池须比用它解析出的文档活得更久; 不是线程安全的
+*/
+struct key_pool;
+key_pool* key_pool_create();
+void key_pool_destroy(key_pool* kp);
+/* 返回 k 在池中的副本, 不存在时加入 */
+const char* key_pool_intern(key_pool* kp, const char* k, size_t len);
+size_t key_pool_size(const key_pool* kp);
 
 int parse(value* v, const char* json);
+/* 解析 [json, json + len), 不要求 '\0' 结尾, 其中的 '\0' 视为错误 */
+int parse(value* v, const char* json, size_t len);
+/* 整棵树(节点与字符串)都分配在 a 中, 无需 Free, arena_release 即释放 */
+int parse_arena(value* v, const char* json, arena* a);
+/* 原地解析: 会改写 json, 字符串与键直接指向 json, 其生命周期须长于 v */
+int parse_insitu(value* v, char* json);
+
+/*
+可复用的解析/输出句柄 (每个线程一个): 在多次调用之间保留 context 栈,
+解析相似的文档时不再分配临时内存. keep 非 0 时, 栈超过 keep 字节就释放, 避免偶尔的大文档长期占用内存
+*/
+struct parser
+{
+    char* stack;
+    size_t size;
+    size_t keep;
+    key_pool* keys;     /* 非空时对象的键取自键池, 见 key_pool */
+};
+
+struct writer
+{
+    char* stack;
+    size_t size;
+    size_t keep;
+};
+
+void parser_init(parser* p, size_t keep);
+void parser_release(parser* p);
+int parse(parser* p, value* v, const char* json, size_t len);
+int parse_arena(parser* p, value* v, const char* json, size_t len, arena* a);
+
+void writer_init(writer* w, size_t keep);
+void writer_release(writer* w);
+/* 结果存放在 w 中, 在下一次调用或 writer_release 之前有效 */
+const char* stringify(writer* w, const value* v, size_t* length);
+
+/*
+SAX 事件接口: 按文档顺序回调, 不建立树, 额外内存只与嵌套深度和最长的转义字符串有关.
+字符串和键以 (s, len) 给出, 只在回调期间有效, 不保证以 '\0' 结尾.
+回调返回 0 则中止解析并返回 PARSE_TERMINATED; 为 nullptr 的回调忽略该事件.
+int64/uint64 未设置时, 整数也经 number 回调.
+*/
+struct handler
+{
+    int (*null)(void* user);
+    int (*boolean)(void* user, int b);
+    int (*number)(void* user, double n);
+    int (*int64)(void* user, int64_t i);
+    int (*uint64)(void* user, uint64_t u);
+    int (*string)(void* user, const char* s, size_t len);
+    int (*start_object)(void* user);
+    int (*key)(void* user, const char* s, size_t len);
+    int (*end_object)(void* user, size_t size);
+    int (*start_array)(void* user);
+    int (*end_array)(void* user, size_t size);
+};
+
+int parse_sax(const char* json, const handler* h, void* user);
+int parse_sax(const char* json, size_t len, const handler* h, void* user);
+
+/*
+增量解析: 输入可分多次 feed, 词法单元 (包括转义、\\uXXXX 与数字) 可以跨块.
+feed 出错后返回同一错误码直到 finish; finish 结束输入并把结果写入 v, 之后可开始下一个文档
+*/
+struct stream_parser;
+stream_parser* stream_parser_create();
+void stream_parser_destroy(stream_parser* sp);
+int feed(stream_parser* sp, const char* chunk, size_t len);
+int finish(stream_parser* sp, value* v);
+
+/*
+NDJSON (JSON Lines): 每行一个文档, 空行跳过. 记录在多个线程上并行解析, 按输入顺序放入 *records,
+出错的记录 status 为错误码且 v 为 null, line 为从 1 开始的行号.
+返回 PARSE_OK 或第一个出错记录的错误码; threads 为 0 时使用全部 CPU.
+结果用 free_ndjson 释放
+*/
+struct ndjson_record
+{
+    value v;
+    int status;
+    size_t line;
+};
+
+int parse_ndjson(const char* json, size_t len, ndjson_record** records, size_t* count, unsigned threads);
+void free_ndjson(ndjson_record* records, size_t count);
+
+/*
+两阶段解析, 适合很大的单个文档: 第一阶段按 64 字节块建立结构字符与字符串边界的索引,
+可分段在 threads 个线程上进行 (0 表示全部 CPU); 第二阶段沿索引建树.
+结果与错误码都与 parse 相同
+*/
+int parse_indexed(value* v, const char* json, size_t len, unsigned threads);
+
 char* stringify(const value* v, size_t* length);
 
+/*
+流式输出: 生成的文本按块交给 sink, 额外内存只有一个固定大小的缓冲区.
+sink 返回 0 表示写入失败, 此后不再调用 sink, 最终返回 PARSE_TERMINATED; 成功返回 PARSE_OK
+*/
+typedef int (*sink_func)(void* user, const char* s, size_t len);
+int stringify_sink(const value* v, sink_func sink, void* user, char* buf, size_t size);  /* size 小于 64 时可能另行分配 */
+int stringify_sink(const value* v, sink_func sink, void* user);                          /* 使用 4KB 栈上缓冲区 */
+int stringify_fd(const value* v, int fd);
+int stringify_to_string(const value* v, std::string* out);   /* 追加到 out */
+
 void Free(value* v);
 
 type get_type(const value* v);
 
-#define set_null(v) Free(v);
+inline void set_null(value* v) { Free(v); }
 
 int get_boolean(const value* v);
 void set_boolean(value* v, int b);
@@ -86,17 +252,501 @@ void set_boolean(value* v, int b);
 double get_number(const value* v);
 void set_number(value* v, double n);
 
+/* 不含小数点和指数的整数在解析时精确保存为 int64/uint64 */
+int is_int64(const value* v);
+int is_uint64(const value* v);
+int64_t get_int64(const value* v);
+void set_int64(value* v, int64_t i);
+uint64_t get_uint64(const value* v);
+void set_uint64(value* v, uint64_t u);
+
 const char* get_string(const value* v);
 size_t get_string_length(const value* v);
 void set_string(value* v, const char* s, size_t len);
 
+/*
+数组与对象按容量成倍增长, 追加均摊 O(1); 解析得到的容器容量等于大小.
+arena 中的元素/成员数组在超出容量时改为在堆上分配, 此后须 Free 该容器;
+不归对象所有的键 (arena/parse_insitu/键池) 在第一次添加成员时逐个复制.
+返回的指针在下一次增删之前有效
+*/
+void set_array(value* v, size_t capacity);
 size_t get_array_size(const value* v);
+size_t get_array_capacity(const value* v);
+void reserve_array(value* v, size_t capacity);
+void shrink_array(value* v);
+void clear_array(value* v);
 value* get_array_element(const value* v, size_t index);
+value* pushback_array_element(value* v);
+void popback_array_element(value* v);
+value* insert_array_element(value* v, size_t index);
+void erase_array_element(value* v, size_t index, size_t count);
 
+void set_object(value* v, size_t capacity);
 size_t get_object_size(const value* v);
+size_t get_object_capacity(const value* v);
+void reserve_object(value* v, size_t capacity);
+void shrink_object(value* v);
+void clear_object(value* v);
 const char* get_object_key(const value* v, size_t index);
 size_t get_object_key_length(const value* v, size_t index);
 value* get_object_value(const value* v, size_t index);
+/* 返回 key 对应的值, 没有该键时在末尾添加值为 null 的成员 */
+value* set_object_value(value* v, const char* key, size_t klen);
+void remove_object_value(value* v, size_t index);
+
+#define KEY_NOT_EXIST ((size_t)-1)
+/*
+按键查找, 有重复键时返回第一个; 成员较多时首次查找会建立哈希索引并缓存在 u.o.index.
+直接改写 u.o.m 之后须调用 reset_object_index. 同一对象的并发查找需要外部同步.
+arena 中的对象不建索引, 总是顺序查找.
+*/
+size_t find_object_index(const value* v, const char* key, size_t klen);
+value* find_object_value(const value* v, const char* key, size_t klen);
+void reset_object_index(value* v);
+
+/*
+copy 把 src 整棵树复制到 dst, 每个字符串、元素数组、成员数组与键都按最终大小分配一次,
+结果完全归 dst 所有 (src 可以在 arena 中或借用输入). move 把 src 转移给 dst 并把 src 置为 null,
+swap 交换两者, 都只搬动根节点, 与子树大小无关. src 可以是 dst 的子节点.
+is_equal 比较两棵树: 数字按数值比较 (1 与 1.0 相等); 对象先按位置比较成员, 位置上的键不同时再按键查找
+(成员多时用哈希索引), 因此不含重复键的对象与成员顺序无关
+*/
+void copy(value* dst, const value* src);
+void move(value* dst, value* src);
+void swap(value* a, value* b);
+int is_equal(const value* a, const value* b);
+
+/*
+JSON Pointer (RFC 6901): compile_pointer 把 "/a/0/b~1c" 拆成记号并解开 ~0 ~1, 数组下标预先转为整数,
+键的哈希预先算好; 编译结果可反复用于多个文档. 对象按键查找 (成员多时用哈希索引), 数组按下标.
+空串指向根. set_by_pointer 把 *v 移入目标位置 (之后 *v 为 null): 目标已存在则替换,
+父对象中没有该键则添加成员, 父数组的下标等于元素数或为 "-" 则追加.
+v 可以在树中 (如目标的子节点或父数组的元素), 但不能是目标的祖先; 失败时 *v 不变.
+增删与 pushback_array_element/set_object_value 相同: 放入 arena 树中的值须在 arena_release 之前 Free 根
+*/
+enum POINTER_STATE {
+    POINTER_OK = 0,
+    POINTER_INVALID_SYNTAX,     /* 非空且不以 '/' 开头, 或 '~' 之后不是 '0'/'1' */
+    POINTER_NOT_FOUND
+};
+
+#define POINTER_NO_INDEX ((size_t)-1)   /* 记号不是合法的数组下标 */
+#define POINTER_END ((size_t)-2)        /* 记号为 "-": 数组末尾之后 */
+
+struct pointer_token
+{
+    const char* key;    /* 解开转义后的记号, '\0' 结尾 */
+    size_t len;
+    size_t index;       /* 数组下标, 或 POINTER_NO_INDEX / POINTER_END */
+    size_t hash;
+};
+
+struct pointer
+{
+    pointer_token* tokens;  /* 与各记号的字符串在同一块内存中 */
+    size_t count;
+};
+
+int compile_pointer(pointer* p, const char* s, size_t len);
+void pointer_release(pointer* p);
+value* get_by_pointer(const value* v, const pointer* p);
+value* get_by_pointer(const value* v, const char* s, size_t len);
+int set_by_pointer(value* root, const pointer* p, value* v);
+int set_by_pointer(value* root, const char* s, size_t len, value* v);
+
+/*
+按需解析: parse_lazy 只检查括号个数配对、字符串闭合以及根之后没有多余内容, 不解码任何值.
+lazy 指向某个值在输入中的位置, 输入须在使用期间有效. 查找元素/成员时跳过不需要的值,
+途经部分的语法随之检查; get_value 把一个值完整解析为 value, 字符串与数字只在此时解码.
+find_object_value 从上次找到的成员开始找, 到结尾后回到开头, 按文档顺序取字段时整个对象只扫一遍.
+查找返回 PARSE_OK 或遇到的错误, 下标或键不存在时 out->json 为 nullptr
+*/
+struct lazy
+{
+    const char* json;   /* 值的第一个字符 */
+    const char* end;    /* 输入的结尾 */
+    const char* next;   /* 对象: 上次找到的成员的位置 */
+};
+
+int parse_lazy(lazy* v, const char* json, size_t len);
+type get_type(const lazy* v);
+int get_array_element(const lazy* v, size_t index, lazy* out);
+int find_object_value(lazy* v, const char* key, size_t klen, lazy* out);
+int get_value(const lazy* v, value* out);
+
+/*
+只读的扁平文档: 整棵树按文档顺序存放在一段连续的 64 位字中, 字符串另存一块缓冲区.
+节点以其在 words 中的下标表示, 根为 0. 下列访问函数与 value 版本同名同义;
+get_array_element/get_object_* 按下标访问需要跳过之前的兄弟, 顺序遍历用 first_child/next_sibling:
+    for (i = first_child(d, n), end = next_sibling(d, n); i != end; i = next_sibling(d, i))
+对象的子节点依次为键 (字符串节点) 和值
+*/
+struct tape
+{
+    uint64_t* words;
+    size_t size;
+    char* strings;
+    size_t strings_size;
+};
+
+int parse_tape(tape* d, const char* json, size_t len);
+void tape_release(tape* d);
+
+type get_type(const tape* d, size_t n);
+int get_boolean(const tape* d, size_t n);
+double get_number(const tape* d, size_t n);
+int is_int64(const tape* d, size_t n);
+int is_uint64(const tape* d, size_t n);
+int64_t get_int64(const tape* d, size_t n);
+uint64_t get_uint64(const tape* d, size_t n);
+const char* get_string(const tape* d, size_t n);
+size_t get_string_length(const tape* d, size_t n);
+size_t get_array_size(const tape* d, size_t n);
+size_t get_array_element(const tape* d, size_t n, size_t index);
+size_t get_object_size(const tape* d, size_t n);
+const char* get_object_key(const tape* d, size_t n, size_t index);
+size_t get_object_key_length(const tape* d, size_t n, size_t index);
+size_t get_object_value(const tape* d, size_t n, size_t index);
+size_t find_object_value(const tape* d, size_t n, const char* key, size_t klen);   /* 不存在时返回 KEY_NOT_EXIST */
+size_t first_child(const tape* d, size_t n);
+size_t next_sibling(const tape* d, size_t n);
+
+/*
+逐个读取词法单元, 供 parse_into 使用; 每个函数先跳过空白.
+reader_string 返回的字符串不含转义时指向输入, 否则在 r->stack 中, 到下一次读取前有效.
+reader_open 读入 open ('[' 或 '{'); reader_close 在 close 时读入并返回 1, 是 ',' 时读入并返回 0.
+reader_mismatch 跳过一个值 (检查其语法), 合法时返回 PARSE_TYPE_MISMATCH
+*/
+struct reader
+{
+    const char* json;
+    const char* end;
+    char* stack;
+    size_t size;
+    size_t depth;       /* 未闭合的数组/对象层数 */
+    const char* field;  /* 出错的字段名 (最内层) */
+};
+
+void reader_init(reader* r, const char* json, size_t len);
+void reader_release(reader* r);
+char reader_peek(reader* r);                            /* 下一个字符, 到结尾时为 '\0' */
+int reader_literal(reader* r, const char* literal);
+int reader_number(reader* r, value* n);                 /* 结果不需要 Free */
+int reader_string(reader* r, const char** s, size_t* len);
+int reader_open(reader* r, char open);
+int reader_close(reader* r, char close, int* closed);
+int reader_end(reader* r);                              /* 根之后只能有空白 */
+int reader_skip(reader* r);
+int reader_mismatch(reader* r);
+
+#ifdef EASYJSON_DOCUMENT
+/*
+C++ 封装 (C++17): Document 拥有一棵树, 只能移动, 析构时 Free; Value 是树中节点的非拥有视图, 只含一个指针.
+各成员函数都是对上面函数的内联转发, 编译结果与直接调用相同. 字符串和键以 std::string_view 给出,
+在节点被修改或释放之前有效. operator[] 按键查找不到时返回空的 Value (转换为 bool 为 false),
+按下标越界与类型不符同 C 接口一样由 assert 检查.
+    for (Value e : v.elements()) ...            数组元素
+    for (Member m : v.members()) ...            对象成员, m.key 与 m.value
+*/
+struct Member;
+
+class Value
+{
+public:
+    Value(value* v = nullptr) noexcept : v_(v) {}
+
+    explicit operator bool() const noexcept { return v_ != nullptr; }
+    value* get() const noexcept { return v_; }
+
+    type get_type() const { return EasyJson::get_type(v_); }
+    bool is_null() const { return EasyJson::get_type(v_) == EASYJson_NULL; }
+    bool get_boolean() const { return EasyJson::get_boolean(v_) != 0; }
+    double get_number() const { return EasyJson::get_number(v_); }
+    bool is_int64() const { return EasyJson::is_int64(v_) != 0; }
+    bool is_uint64() const { return EasyJson::is_uint64(v_) != 0; }
+    int64_t get_int64() const { return EasyJson::get_int64(v_); }
+    uint64_t get_uint64() const { return EasyJson::get_uint64(v_); }
+    std::string_view get_string() const { return std::string_view(EasyJson::get_string(v_), get_string_length(v_)); }
+
+    /* 数组的元素数或对象的成员数 */
+    size_t size() const { return v_->type == EASYJson_ARRAY ? get_array_size(v_) : get_object_size(v_); }
+    Value operator[](size_t index) const { return get_array_element(v_, index); }
+    Value operator[](int index) const { return get_array_element(v_, (size_t)index); }     /* 使 v[0] 不与 const char* 歧义 */
+    Value operator[](std::string_view key) const { return find_object_value(v_, key.data(), key.size()); }
+    Value operator[](const char* key) const { return (*this)[std::string_view(key)]; }
+
+    void set_null() { Free(v_); }
+    void set_boolean(bool b) { EasyJson::set_boolean(v_, b); }
+    void set_number(double n) { EasyJson::set_number(v_, n); }
+    void set_int64(int64_t i) { EasyJson::set_int64(v_, i); }
+    void set_uint64(uint64_t u) { EasyJson::set_uint64(v_, u); }
+    void set_string(std::string_view s) { EasyJson::set_string(v_, s.data(), s.size()); }
+    void set_array(size_t capacity = 0) { EasyJson::set_array(v_, capacity); }
+    void set_object(size_t capacity = 0) { EasyJson::set_object(v_, capacity); }
+    Value pushback() { return pushback_array_element(v_); }
+    /* 没有该键时添加值为 null 的成员 */
+    Value set(std::string_view key) { return set_object_value(v_, key.data(), key.size()); }
+
+    /* 元素/成员数组上的区间, 迭代时把指针包装为 E */
+    template <typename T, typename E>
+    class range
+    {
+    public:
+        class iterator
+        {
+        public:
+            iterator(T* p) noexcept : p_(p) {}
+            E operator*() const noexcept { return E::make(p_); }
+            iterator& operator++() noexcept { ++p_; return *this; }
+            bool operator!=(const iterator& o) const noexcept { return p_ != o.p_; }
+        private:
+            T* p_;
+        };
+        range(T* b, size_t n) noexcept : b_(b), n_(n) {}
+        iterator begin() const noexcept { return b_; }
+        iterator end() const noexcept { return b_ + n_; }
+    private:
+        T* b_;
+        size_t n_;
+    };
+
+    static Value make(value* v) noexcept { return v; }
+    range<value, Value> elements() const { return { v_->u.a.e, get_array_size(v_) }; }
+    range<member, Member> members() const;
+
+private:
+    value* v_;
+};
+
+struct Member
+{
+    std::string_view key;
+    Value value;
+
+    static Member make(member* m) noexcept { return { std::string_view(m->k, m->klen), &m->v }; }
+};
+
+inline Value::range<member, Member> Value::members() const { return { v_->u.o.m, get_object_size(v_) }; }
+
+class Document
+{
+public:
+    Document() noexcept { init(&v_); }
+    ~Document() { Free(&v_); }
+    Document(Document&& o) noexcept { init(&v_); EasyJson::swap(&v_, &o.v_); }
+    Document& operator=(Document&& o) noexcept { EasyJson::move(&v_, &o.v_); return *this; }
+    Document(const Document&) = delete;
+    Document& operator=(const Document&) = delete;
+
+    /* 失败时为 null */
+    int parse(std::string_view json) {
+        Free(&v_);
+        return EasyJson::parse(&v_, json.data(), json.size());
+    }
+    Document copy() const {
+        Document d;
+        EasyJson::copy(&d.v_, &v_);
+        return d;
+    }
+    std::string stringify() const {
+        std::string s;
+        stringify_to_string(&v_, &s);
+        return s;
+    }
+    bool operator==(const Document& o) const { return is_equal(&v_, &o.v_) != 0; }
+
+    Value root() noexcept { return &v_; }
+    Value operator[](size_t index) { return root()[index]; }
+    Value operator[](int index) { return root()[index]; }
+    Value operator[](std::string_view key) { return root()[key]; }
+    Value operator[](const char* key) { return root()[key]; }
+    value* get() noexcept { return &v_; }
+
+private:
+    value v_;
+};
+
+/*
+按字段直接解析到结构体, 不建立 value 树. 在结构体所在的命名空间中列出字段一次:
+    struct point { int64_t x, y; std::string name; std::optional<std::vector<int>> tags; };
+    EASYJSON_BIND(point, EASYJSON_FIELD(point, x), EASYJSON_FIELD(point, y), EASYJSON_FIELD_NAMED(point, name, "label"),
+                  EASYJSON_FIELD(point, tags));
+    int ret = parse_into(&p, json, len, &field);
+字段可以是 bool、整数 (只接受不带小数点和指数的整数, 超出范围为 PARSE_TYPE_MISMATCH)、浮点数、
+std::string、std::vector、std::optional (可以缺少或为 null) 以及同样绑定过的结构体.
+键按长度与内容同编译期的字段名比较, 未列出的键跳过 (检查语法). 出错时 *field 为最内层出错或缺少的字段名
+*/
+template <typename T, typename M>
+struct field
+{
+    const char* name;
+    size_t len;
+    M T::* ptr;
+};
+
+#define EASYJSON_FIELD(T, m) EasyJson::field<T, decltype(T::m)>{ #m, sizeof(#m) - 1, &T::m }
+#define EASYJSON_FIELD_NAMED(T, m, key) EasyJson::field<T, decltype(T::m)>{ key, sizeof(key) - 1, &T::m }
+#define EASYJSON_BIND(T, ...) constexpr auto easyjson_fields(const T*) { return std::make_tuple(__VA_ARGS__); }
+
+template <typename M> struct is_vector : std::false_type {};
+template <typename E> struct is_vector<std::vector<E>> : std::true_type {};
+template <typename M> struct is_optional : std::false_type {};
+template <typename E> struct is_optional<std::optional<E>> : std::true_type {};
+
+template <typename M> int read_field(reader* r, M* out);
+
+template <typename M>
+int read_integer(const value* n, M* out) {
+    if (n->flags & FLAG_INT64) {
+        if constexpr (std::is_signed_v<M>) {
+            if (n->u.i64 < std::numeric_limits<M>::min() || n->u.i64 > std::numeric_limits<M>::max())
+                return PARSE_TYPE_MISMATCH;
+        }
+        else if (n->u.i64 < 0 || (uint64_t)n->u.i64 > std::numeric_limits<M>::max())
+            return PARSE_TYPE_MISMATCH;
+        *out = (M)n->u.i64;
+        return PARSE_OK;
+    }
+    if (!(n->flags & FLAG_UINT64) || std::is_signed_v<M> || n->u.u64 > std::numeric_limits<M>::max())
+        return PARSE_TYPE_MISMATCH;
+    *out = (M)n->u.u64;
+    return PARSE_OK;
+}
+
+/* 输入中可能缺少 std::optional 字段, 读对象之前先清空, 复用的结构体不会留下旧值 */
+template <typename M>
+void reset_optional(M* m) {
+    if constexpr (is_optional<M>::value)
+        m->reset();
+}
+
+/* 第 I 个字段的名字与 (k, klen) 相同时读入其值 */
+template <size_t I, typename T, typename F>
+bool read_member(reader* r, T* out, const F& fields, bool* seen, const char* k, size_t klen, int* ret) {
+    const auto& f = std::get<I>(fields);
+    if (klen != f.len || memcmp(k, f.name, klen) != 0)
+        return false;
+    seen[I] = true;
+    if ((*ret = read_field(r, &(out->*f.ptr))) != PARSE_OK && !r->field)
+        r->field = f.name;
+    return true;
+}
+
+template <typename T, size_t... I>
+int read_object(reader* r, T* out, std::index_sequence<I...>) {
+    constexpr auto fields = easyjson_fields((const T*)nullptr);
+    bool seen[sizeof...(I) + 1] = {};
+    const char* k;
+    size_t klen;
+    int ret, closed;
+    if ((ret = reader_open(r, '{')) != PARSE_OK)
+        return ret;
+    (reset_optional(&(out->*std::get<I>(fields).ptr)), ...);
+    if (reader_peek(r) == '}')
+        reader_close(r, '}', &closed);
+    else {
+        do {
+            if (reader_peek(r) != '"')
+                return PARSE_MISS_KEY;
+            if ((ret = reader_string(r, &k, &klen)) != PARSE_OK)
+                return ret;
+            if (reader_peek(r) != ':')
+                return PARSE_MISS_COLON;
+            r->json++;
+            ret = PARSE_OK;
+            if (!(read_member<I>(r, out, fields, seen, k, klen, &ret) || ...))
+                ret = reader_skip(r);
+            if (ret != PARSE_OK || (ret = reader_close(r, '}', &closed)) != PARSE_OK)
+                return ret;
+        } while (!closed);
+    }
+    /* std::optional 字段可以缺少 */
+    ret = PARSE_OK;
+    ((ret == PARSE_OK && !seen[I] && !is_optional<std::decay_t<decltype(out->*std::get<I>(fields).ptr)>>::value
+        ? (r->field = std::get<I>(fields).name, ret = PARSE_MISS_FIELD) : 0), ...);
+    return ret;
+}
+
+template <typename M>
+int read_field(reader* r, M* out) {
+    value n;
+    int ret, closed;
+    char ch = reader_peek(r);
+    if constexpr (std::is_same_v<M, bool>) {
+        if (ch != 't' && ch != 'f')
+            return reader_mismatch(r);
+        if ((ret = reader_literal(r, ch == 't' ? "true" : "false")) == PARSE_OK)
+            *out = ch == 't';
+        return ret;
+    }
+    else if constexpr (std::is_arithmetic_v<M>) {
+        if (ch != '-' && (ch < '0' || ch > '9'))
+            return reader_mismatch(r);
+        if ((ret = reader_number(r, &n)) != PARSE_OK)
+            return ret;
+        if constexpr (std::is_floating_point_v<M>) {
+            *out = (M)get_number(&n);
+            return PARSE_OK;
+        }
+        else
+            return read_integer(&n, out);
+    }
+    else if constexpr (std::is_same_v<M, std::string>) {
+        const char* s;
+        size_t len;
+        if (ch != '"')
+            return reader_mismatch(r);
+        if ((ret = reader_string(r, &s, &len)) == PARSE_OK)
+            out->assign(s, len);
+        return ret;
+    }
+    else if constexpr (is_optional<M>::value) {
+        if (ch == 'n') {
+            out->reset();
+            return reader_literal(r, "null");
+        }
+        return read_field(r, &out->emplace());
+    }
+    else if constexpr (is_vector<M>::value) {
+        out->clear();
+        if ((ret = reader_open(r, '[')) != PARSE_OK)
+            return ret;
+        if (reader_peek(r) == ']')
+            return reader_close(r, ']', &closed);
+        do {
+            if constexpr (std::is_same_v<M, std::vector<bool>>) {
+                /* vector<bool> 的元素不能取地址 */
+                bool b;
+                if ((ret = read_field(r, &b)) == PARSE_OK)
+                    out->push_back(b);
+            }
+            else
+                ret = read_field(r, &out->emplace_back());
+            if (ret != PARSE_OK || (ret = reader_close(r, ']', &closed)) != PARSE_OK)
+                return ret;
+        } while (!closed);
+        return PARSE_OK;
+    }
+    else {
+        constexpr size_t n_fields = std::tuple_size_v<decltype(easyjson_fields((const M*)nullptr))>;
+        return read_object(r, out, std::make_index_sequence<n_fields>());
+    }
+}
+
+template <typename T>
+int parse_into(T* out, const char* json, size_t len, const char** field = nullptr) {
+    reader r;
+    int ret;
+    reader_init(&r, json, len);
+    if ((ret = read_field(&r, out)) == PARSE_OK)
+        ret = reader_end(&r);
+    if (field)
+        *field = r.field;
+    reader_release(&r);
+    return ret;
+}
+#endif
 }
 
 #endif
\ No newline at end of file
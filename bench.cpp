@@ -0,0 +1,1105 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include "EasyJson.hpp"
+
+using namespace EasyJson;
+
+/*
+性能测试: g++ -O2 bench.cpp EasyJson.cpp -o bench
+加 -DEASYJSON_NO_SIMD 编译可得到标量扫描的对照结果
+*/
+
+struct buffer
+{
+    char* s;
+    size_t len, cap;
+};
+
+static void buffer_puts(buffer* b, const char* s) {
+    size_t n = strlen(s);
+    if (b->len + n + 1 > b->cap) {
+        while (b->len + n + 1 > b->cap)
+            b->cap = b->cap ? b->cap * 2 : 4096;
+        b->s = (char*)realloc(b->s, b->cap);
+    }
+    memcpy(b->s + b->len, s, n + 1);
+    b->len += n;
+}
+
+/* 生成 n 条记录组成的数组 */
+static char* make_records(size_t n) {
+    buffer b = { nullptr, 0, 0 };
+    char tmp[256];
+    buffer_puts(&b, "[");
+    for (size_t i = 0; i < n; i++) {
+        snprintf(tmp, sizeof(tmp),
+            "%s{\"id\":%zu,\"name\":\"user_%zu\",\"score\":%zu.25,\"active\":%s,"
+            "\"tags\":[\"alpha\",\"beta\",\"gamma\"],\"address\":{\"city\":\"Hangzhou\",\"zip\":\"310000\"}}",
+            i ? "," : "", i, i, i % 1000, i % 2 ? "true" : "false");
+        buffer_puts(&b, tmp);
+    }
+    buffer_puts(&b, "]");
+    return b.s;
+}
+
+/* 与 make_records 相同的记录, 每行一条 */
+static char* make_ndjson(size_t n) {
+    buffer b = { nullptr, 0, 0 };
+    char tmp[256];
+    for (size_t i = 0; i < n; i++) {
+        snprintf(tmp, sizeof(tmp),
+            "{\"id\":%zu,\"name\":\"user_%zu\",\"score\":%zu.25,\"active\":%s,"
+            "\"tags\":[\"alpha\",\"beta\",\"gamma\"],\"address\":{\"city\":\"Hangzhou\",\"zip\":\"310000\"}}\n",
+            i, i, i % 1000, i % 2 ? "true" : "false");
+        buffer_puts(&b, tmp);
+    }
+    return b.s;
+}
+
+/* 生成 n 个长字符串组成的数组, 每 8 个中有一个带转义 */
+static char* make_strings(size_t n, size_t len) {
+    buffer b = { nullptr, 0, 0 };
+    char* tmp = (char*)malloc(len + 8);
+    buffer_puts(&b, "[");
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < len; j++)
+            tmp[j] = 'a' + (i + j) % 26;
+        if (i % 8 == 0)
+            memcpy(tmp + len / 2, "\\n", 2);
+        tmp[len] = '\0';
+        buffer_puts(&b, i ? ",\"" : "\"");
+        buffer_puts(&b, tmp);
+        buffer_puts(&b, "\"");
+    }
+    buffer_puts(&b, "]");
+    free(tmp);
+    return b.s;
+}
+
+/* 生成 n 个数字组成的数组: 整数、短小数与 17 位有效数字的随机 double 各占三分之一 */
+static char* make_numbers(size_t n) {
+    buffer b = { nullptr, 0, 0 };
+    char tmp[64];
+    unsigned long long x = 88172645463325252ULL;
+    buffer_puts(&b, "[");
+    for (size_t i = 0; i < n; i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        if (i % 3 == 0)
+            snprintf(tmp, sizeof(tmp), "%s%llu", i ? "," : "", x % 100000000);
+        else if (i % 3 == 1)
+            snprintf(tmp, sizeof(tmp), "%s%llu.%02llu", i ? "," : "", x % 10000, x / 7 % 100);
+        else
+            snprintf(tmp, sizeof(tmp), "%s%.17g", i ? "," : "", (double)(x >> 11) / (1ULL << 53) * 1e6);
+        buffer_puts(&b, tmp);
+    }
+    buffer_puts(&b, "]");
+    return b.s;
+}
+
+/* 生成 n 个 64 位整数组成的数组 */
+static char* make_integers(size_t n) {
+    buffer b = { nullptr, 0, 0 };
+    char tmp[64];
+    unsigned long long x = 88172645463325252ULL;
+    buffer_puts(&b, "[");
+    for (size_t i = 0; i < n; i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        snprintf(tmp, sizeof(tmp), "%s%lld", i ? "," : "", (long long)x >> (i % 48));
+        buffer_puts(&b, tmp);
+    }
+    buffer_puts(&b, "]");
+    return b.s;
+}
+
+/* 生成 n 个嵌套 depth 层的数组组成的数组 */
+static char* make_deep(size_t n, size_t depth) {
+    buffer b = { nullptr, 0, 0 };
+    char* item = (char*)malloc(2 * depth + 2);
+    size_t i;
+    memset(item, '[', depth);
+    item[depth] = '1';
+    memset(item + depth + 1, ']', depth);
+    item[2 * depth + 1] = '\0';
+    buffer_puts(&b, "[");
+    for (i = 0; i < n; i++) {
+        buffer_puts(&b, i ? "," : "");
+        buffer_puts(&b, item);
+    }
+    buffer_puts(&b, "]");
+    free(item);
+    return b.s;
+}
+
+static void indent(buffer* b, int depth) {
+    buffer_puts(b, "\n");
+    for (int i = 0; i < depth; i++)
+        buffer_puts(b, "    ");
+}
+
+/* 以 4 空格缩进重新输出 v */
+static void pretty(buffer* b, const value* v, int depth) {
+    size_t i, len;
+    char* s;
+    switch (get_type(v)) {
+        case EASYJson_ARRAY:
+            buffer_puts(b, "[");
+            for (i = 0; i < get_array_size(v); i++) {
+                buffer_puts(b, i ? "," : "");
+                indent(b, depth + 1);
+                pretty(b, get_array_element(v, i), depth + 1);
+            }
+            indent(b, depth);
+            buffer_puts(b, "]");
+            break;
+        case EASYJson_OBJECT:
+            buffer_puts(b, "{");
+            for (i = 0; i < get_object_size(v); i++) {
+                buffer_puts(b, i ? "," : "");
+                indent(b, depth + 1);
+                buffer_puts(b, "\"");
+                buffer_puts(b, get_object_key(v, i));
+                buffer_puts(b, "\": ");
+                pretty(b, get_object_value(v, i), depth + 1);
+            }
+            indent(b, depth);
+            buffer_puts(b, "}");
+            break;
+        default:
+            s = stringify(v, &len);
+            buffer_puts(b, s);
+            free(s);
+    }
+}
+
+static char* make_indented(const char* json) {
+    buffer b = { nullptr, 0, 0 };
+    value v;
+    parse(&v, json);
+    pretty(&b, &v, 0);
+    Free(&v);
+    return b.s;
+}
+
+template <typename F>
+static double bench(const char* name, size_t bytes, int iterations, F f) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+        f();
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("%-32s %9.3f ms/iter %9.1f MB/s\n", name, sec * 1000 / iterations, bytes * (double)iterations / sec / 1e6);
+    return sec;
+}
+
+static void bench_arena() {
+    char* json = make_records(100000);
+    size_t len = strlen(json);
+    printf("-- arena (%zu bytes)\n", len);
+    bench("parse + Free", len, 10, [&] {
+        value v;
+        parse(&v, json);
+        Free(&v);
+    });
+    bench("parse_arena + arena_release", len, 10, [&] {
+        arena a;
+        value v;
+        arena_init(&a, nullptr, 0);
+        parse_arena(&v, json, &a);
+        arena_release(&a);
+    });
+    free(json);
+}
+
+static void bench_insitu() {
+    char* json = make_records(100000);
+    size_t len = strlen(json);
+    char* buf = (char*)malloc(len + 1);
+    printf("-- insitu (%zu bytes)\n", len);
+    bench("parse + Free", len, 10, [&] {
+        value v;
+        parse(&v, json);
+        Free(&v);
+    });
+    bench("memcpy + parse_insitu + Free", len, 10, [&] {
+        value v;
+        memcpy(buf, json, len + 1);
+        parse_insitu(&v, buf);
+        Free(&v);
+    });
+    free(buf);
+    free(json);
+}
+
+static void bench_length() {
+    char* json = make_records(100000);
+    size_t len = strlen(json);
+    printf("-- length-delimited (%zu bytes)\n", len);
+    bench("parse(json)", len, 10, [&] {
+        value v;
+        parse(&v, json);
+        Free(&v);
+    });
+    bench("parse(json, len)", len, 10, [&] {
+        value v;
+        parse(&v, json, len);
+        Free(&v);
+    });
+    free(json);
+}
+
+static void bench_whitespace() {
+    char* minified = make_records(100000);
+    char* indented = make_indented(minified);
+    size_t len1 = strlen(minified), len2 = strlen(indented);
+    printf("-- whitespace (minified %zu bytes, indented %zu bytes)\n", len1, len2);
+    /* 用 arena 排除 malloc 的干扰 */
+    bench("parse_arena minified", len1, 10, [&] {
+        arena a;
+        value v;
+        arena_init(&a, nullptr, 0);
+        parse_arena(&v, minified, &a);
+        arena_release(&a);
+    });
+    bench("parse_arena indented", len2, 10, [&] {
+        arena a;
+        value v;
+        arena_init(&a, nullptr, 0);
+        parse_arena(&v, indented, &a);
+        arena_release(&a);
+    });
+    free(indented);
+    free(minified);
+}
+
+static void bench_strings() {
+    char* json = make_strings(100000, 200);
+    size_t len = strlen(json);
+    printf("-- long strings (%zu bytes)\n", len);
+    bench("parse_arena", len, 10, [&] {
+        arena a;
+        value v;
+        arena_init(&a, nullptr, 0);
+        parse_arena(&v, json, &a);
+        arena_release(&a);
+    });
+    free(json);
+}
+
+static void bench_numbers() {
+    char* json = make_numbers(1000000);
+    size_t len = strlen(json);
+    printf("-- numbers (%zu bytes)\n", len);
+    bench("parse_arena", len, 10, [&] {
+        arena a;
+        value v;
+        arena_init(&a, nullptr, 0);
+        parse_arena(&v, json, &a);
+        arena_release(&a);
+    });
+    bench("strtod over the same text", len, 10, [&] {
+        const char* p = json + 1;
+        double sum = 0;
+        while (*p) {
+            char* q;
+            sum += strtod(p, &q);
+            p = q + 1;
+        }
+        if (sum == 0.5)
+            puts("");
+    });
+    free(json);
+}
+
+static void bench_stringify_numbers() {
+    char* json = make_numbers(1000000);
+    size_t len = 0;
+    value v;
+    parse(&v, json);
+    free(stringify(&v, &len));
+    printf("-- stringify numbers (%zu bytes in, %zu bytes out)\n", strlen(json), len);
+    bench("stringify", len, 10, [&] {
+        free(stringify(&v, nullptr));
+    });
+    Free(&v);
+    free(json);
+}
+
+static void bench_integers() {
+    char* json = make_integers(1000000);
+    size_t len = strlen(json);
+    printf("-- integers (%zu bytes)\n", len);
+    bench("parse_arena", len, 10, [&] {
+        arena a;
+        value v;
+        arena_init(&a, nullptr, 0);
+        parse_arena(&v, json, &a);
+        arena_release(&a);
+    });
+    value v;
+    parse(&v, json);
+    bench("stringify", len, 10, [&] {
+        free(stringify(&v, nullptr));
+    });
+    Free(&v);
+    free(json);
+}
+
+/* 生成有 n 个键 "field_0".."field_{n-1}" 的对象 */
+static char* make_object(size_t n) {
+    buffer b = { nullptr, 0, 0 };
+    char tmp[64];
+    buffer_puts(&b, "{");
+    for (size_t i = 0; i < n; i++) {
+        snprintf(tmp, sizeof(tmp), "%s\"field_%zu\":%zu", i ? "," : "", i, i);
+        buffer_puts(&b, tmp);
+    }
+    buffer_puts(&b, "}");
+    return b.s;
+}
+
+/* 逐一读取对象的每个键: 顺序扫描 vs find_object_value (加 -DOBJECT_INDEX_THRESHOLD=1 编译可看到小对象的哈希查找) */
+static void bench_find() {
+    printf("-- keyed lookup, every key of an n-member object (ns per lookup)\n");
+    for (size_t n = 2; n <= 1024; n *= 2) {
+        char* json = make_object(n);
+        char (*keys)[16] = (char (*)[16])malloc(n * 16);
+        size_t sum = 0, rounds = 4000000 / n + 1;
+        value v;
+        parse(&v, json);
+        for (size_t i = 0; i < n; i++)
+            snprintf(keys[i], 16, "field_%zu", i * 7 % n);
+        auto time = [&](bool indexed) {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t r = 0; r < rounds; r++)
+                for (size_t i = 0; i < n; i++) {
+                    const char* key = keys[i];
+                    size_t klen = strlen(key);
+                    if (indexed)
+                        sum += find_object_value(&v, key, klen)->type;
+                    else
+                        for (size_t j = 0; j < n; j++)
+                            if (get_object_key_length(&v, j) == klen && memcmp(get_object_key(&v, j), key, klen) == 0) {
+                                sum += get_object_value(&v, j)->type;
+                                break;
+                            }
+                }
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e9 / (rounds * n);
+        };
+        double scan = time(false), find = time(true);
+        printf("n = %-5zu scan %8.1f  find_object_value %8.1f%s\n", n, scan, find, sum == 1 ? " " : "");
+        Free(&v);
+        free(keys);
+        free(json);
+    }
+}
+
+/* 对每条记录取 /address/zip 与 /tags/2: 手写逐层查找, 每次解析路径, 预先编译路径 (ns per lookup) */
+static void bench_pointer() {
+    char* json = make_records(100000);
+    size_t i, n, sum = 0;
+    pointer zip, tag;
+    value v;
+    parse(&v, json);
+    n = get_array_size(&v);
+    compile_pointer(&zip, "/address/zip", 12);
+    compile_pointer(&tag, "/tags/2", 7);
+    printf("-- JSON Pointer, 2 paths on each of %zu records (ns per lookup)\n", n);
+    auto time = [&](const char* name, int mode) {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < 20; r++)
+            for (i = 0; i < n; i++) {
+                const value* e = get_array_element(&v, i);
+                const value *a, *b;
+                if (mode == 0) {
+                    a = find_object_value(find_object_value(e, "address", 7), "zip", 3);
+                    b = get_array_element(find_object_value(e, "tags", 4), 2);
+                }
+                else if (mode == 1) {
+                    a = get_by_pointer(e, "/address/zip", 12);
+                    b = get_by_pointer(e, "/tags/2", 7);
+                }
+                else {
+                    a = get_by_pointer(e, &zip);
+                    b = get_by_pointer(e, &tag);
+                }
+                sum += get_string_length(a) + get_string_length(b);
+            }
+        double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        printf("%-32s %9.1f\n", name, sec * 1e9 / (20 * 2 * n));
+    };
+    time("find_object_value chain", 0);
+    time("get_by_pointer (string)", 1);
+    time("get_by_pointer (compiled)", 2);
+    if (sum == 1)
+        printf("\n");
+    pointer_release(&zip);
+    pointer_release(&tag);
+    Free(&v);
+    free(json);
+}
+
+/* 复制整棵树: stringify + parse vs copy; 以及 is_equal */
+static void bench_copy() {
+    char* json = make_records(100000);
+    size_t len = strlen(json);
+    int equal = 1;
+    value v, w;
+    parse(&v, json);
+    init(&w);
+    printf("-- copy (%zu bytes of JSON)\n", len);
+    bench("stringify + parse", len, 5, [&] {
+        size_t n;
+        char* s = stringify(&v, &n);
+        Free(&w);
+        parse(&w, s, n);
+        free(s);
+    });
+    bench("copy", len, 5, [&] { copy(&w, &v); });
+    bench("is_equal", len, 5, [&] { equal &= is_equal(&v, &w); });
+    if (!equal)
+        printf("copy differs\n");
+    Free(&w);
+    Free(&v);
+    free(json);
+}
+
+/* 用 API 直接建树: 10 万条记录的数组, 以及 10 万个成员的对象 (边加边查重) */
+static void bench_build() {
+    const size_t n = 100000;
+    char key[32];
+    char* records = make_records(n);
+    char* object = make_object(n);
+    size_t len = strlen(records), olen = strlen(object);
+    free(records);
+    free(object);
+    printf("-- build %zu records / %zu-member object (MB/s of equivalent JSON)\n", n, n);
+    bench("text + parse (records)", len, 5, [&] {
+        char* json = make_records(n);
+        value v;
+        parse(&v, json);
+        Free(&v);
+        free(json);
+    });
+    bench("pushback + set_object_value", len, 5, [&] {
+        value v, *r, *t;
+        init(&v);
+        set_array(&v, 0);
+        for (size_t i = 0; i < n; i++) {
+            set_object(r = pushback_array_element(&v), 0);
+            set_int64(set_object_value(r, "id", 2), (int64_t)i);
+            sprintf(key, "user_%zu", i);
+            set_string(set_object_value(r, "name", 4), key, strlen(key));
+            set_number(set_object_value(r, "score", 5), i % 1000 + 0.25);
+            set_boolean(set_object_value(r, "active", 6), i % 2);
+            set_array(t = set_object_value(r, "tags", 4), 3);
+            set_string(pushback_array_element(t), "alpha", 5);
+            set_string(pushback_array_element(t), "beta", 4);
+            set_string(pushback_array_element(t), "gamma", 5);
+            set_object(t = set_object_value(r, "address", 7), 2);
+            set_string(set_object_value(t, "city", 4), "Hangzhou", 8);
+            set_string(set_object_value(t, "zip", 3), "310000", 6);
+        }
+        Free(&v);
+    });
+    bench("set_object_value (1 object)", olen, 5, [&] {
+        value v;
+        init(&v);
+        set_object(&v, 0);
+        for (size_t i = 0; i < n; i++) {
+            size_t klen = (size_t)sprintf(key, "field_%zu", i);
+            set_int64(set_object_value(&v, key, klen), (int64_t)i);
+        }
+        Free(&v);
+    });
+}
+
+#ifdef EASYJSON_DOCUMENT
+/* 同一遍历分别用 C 接口与 Document/Value 封装写出, 可用 objdump -d 对照两个函数: 封装没有额外的调用 */
+__attribute__((noinline)) static double walk_direct(const value* v) {
+    double sum = 0;
+    for (size_t i = 0, n = get_array_size(v); i < n; i++) {
+        const value* r = get_array_element(v, i);
+        const value* tags;
+        sum += get_number(find_object_value(r, "score", 5));
+        sum += get_string_length(find_object_value(r, "name", 4));
+        tags = find_object_value(r, "tags", 4);
+        for (size_t j = 0, m = get_array_size(tags); j < m; j++)
+            sum += get_string_length(get_array_element(tags, j));
+    }
+    return sum;
+}
+
+__attribute__((noinline)) static double walk_wrapper(Value v) {
+    double sum = 0;
+    for (Value r : v.elements()) {
+        sum += r["score"].get_number();
+        sum += r["name"].get_string().size();
+        for (Value t : r["tags"].elements())
+            sum += t.get_string().size();
+    }
+    return sum;
+}
+
+static void bench_document() {
+    char* json = make_records(100000);
+    size_t len = strlen(json);
+    double s1 = 0, s2 = 0;
+    Document d;
+    d.parse(json);
+    printf("-- walk records: C API vs Document/Value (%zu bytes)\n", len);
+    bench("C API", len, 20, [&] { s1 += walk_direct(d.get()); });
+    bench("Document/Value", len, 20, [&] { s2 += walk_wrapper(d.root()); });
+    if (s1 != s2)
+        printf("sum mismatch\n");
+    free(json);
+}
+
+struct bench_address
+{
+    std::string city, zip;
+};
+EASYJSON_BIND(bench_address, EASYJSON_FIELD(bench_address, city), EASYJSON_FIELD(bench_address, zip))
+
+struct bench_record
+{
+    uint64_t id;
+    std::string name;
+    double score;
+    bool active;
+    std::vector<std::string> tags;
+    bench_address address;
+};
+EASYJSON_BIND(bench_record, EASYJSON_FIELD(bench_record, id), EASYJSON_FIELD(bench_record, name),
+              EASYJSON_FIELD(bench_record, score), EASYJSON_FIELD(bench_record, active),
+              EASYJSON_FIELD(bench_record, tags), EASYJSON_FIELD(bench_record, address))
+
+/* 建树后按键取值填入结构体, 作为 parse_into 的对照 */
+static void read_records(Value root, std::vector<bench_record>* out) {
+    out->clear();
+    for (Value e : root.elements()) {
+        bench_record& r = out->emplace_back();
+        r.id = e["id"].get_uint64();
+        r.name = e["name"].get_string();
+        r.score = e["score"].get_number();
+        r.active = e["active"].get_boolean();
+        for (Value t : e["tags"].elements())
+            r.tags.emplace_back(t.get_string());
+        r.address.city = e["address"]["city"].get_string();
+        r.address.zip = e["address"]["zip"].get_string();
+    }
+}
+
+static void bench_parse_into() {
+    char* json = make_records(100000);
+    size_t len = strlen(json);
+    std::vector<bench_record> a, b;
+    printf("-- records into structs (%zu bytes)\n", len);
+    bench("parse + read from tree", len, 10, [&] {
+        Document d;
+        d.parse(std::string_view(json, len));
+        read_records(d.root(), &a);
+    });
+    bench("parse_into", len, 10, [&] { parse_into(&b, json, len); });
+    if (a.size() != b.size() || a.back().name != b.back().name || a.back().address.zip != b.back().address.zip)
+        printf("records mismatch\n");
+    free(json);
+}
+#endif
+
+/* 汇总每条记录的 score 字段: SAX 回调 vs 建树后遍历 */
+struct score_sum
+{
+    double sum;
+    int is_score;
+};
+
+static int on_key(void* user, const char* s, size_t len) {
+    ((score_sum*)user)->is_score = len == 5 && memcmp(s, "score", 5) == 0;
+    return 1;
+}
+
+static int on_number(void* user, double n) {
+    score_sum* t = (score_sum*)user;
+    if (t->is_score)
+        t->sum += n;
+    return 1;
+}
+
+static void bench_sax() {
+    char* json = make_records(100000);
+    size_t len = strlen(json);
+    double sum = 0;
+    printf("-- sum of \"score\" (%zu bytes)\n", len);
+    bench("parse + find_object_value + Free", len, 10, [&] {
+        value v;
+        parse(&v, json, len);
+        for (size_t i = 0; i < get_array_size(&v); i++)
+            sum += get_number(find_object_value(get_array_element(&v, i), "score", 5));
+        Free(&v);
+    });
+    bench("parse_sax", len, 10, [&] {
+        handler h = {};
+        score_sum t = { 0, 0 };
+        h.key = on_key;
+        h.number = on_number;
+        parse_sax(json, len, &h, &t);
+        sum -= t.sum;
+    });
+    if (sum != 0)
+        printf("sum mismatch %g\n", sum);
+    free(json);
+}
+
+static void bench_stream() {
+    char* json = make_records(100000);
+    size_t len = strlen(json);
+    stream_parser* sp = stream_parser_create();
+    printf("-- incremental (%zu bytes)\n", len);
+    bench("parse(json, len)", len, 10, [&] {
+        value v;
+        parse(&v, json, len);
+        Free(&v);
+    });
+    for (size_t chunk = 1024; chunk <= 65536; chunk *= 8) {
+        char name[64];
+        snprintf(name, sizeof(name), "feed %zu-byte chunks + finish", chunk);
+        bench(name, len, 10, [&] {
+            value v;
+            for (size_t p = 0; p < len; p += chunk)
+                feed(sp, json + p, len - p < chunk ? len - p : chunk);
+            finish(sp, &v);
+            Free(&v);
+        });
+    }
+    stream_parser_destroy(sp);
+    free(json);
+}
+
+static void bench_stringify_sink() {
+    char* json = make_records(100000);
+    size_t len = strlen(json);
+    int fd = open("/dev/null", O_WRONLY);
+    value v;
+    parse(&v, json, len);
+    printf("-- stringify to a sink (%zu bytes)\n", len);
+    bench("stringify + write", len, 10, [&] {
+        size_t n;
+        char* s = stringify(&v, &n);
+        if (write(fd, s, n) != (ssize_t)n)
+            puts("write failed");
+        free(s);
+    });
+    bench("stringify_fd (4KB chunks)", len, 10, [&] {
+        stringify_fd(&v, fd);
+    });
+    bench("stringify_to_string", len, 10, [&] {
+        std::string out;
+        stringify_to_string(&v, &out);
+    });
+    Free(&v);
+    close(fd);
+    free(json);
+}
+
+/* 嵌套很深与很宽的输入分别测 parse/stringify/Free */
+static void bench_depth() {
+    char* deep = make_deep(10000, 500);
+    char* wide = make_records(100000);
+    struct { const char* name; char* json; } inputs[] = { { "deep", deep }, { "wide", wide } };
+    for (auto& in : inputs) {
+        size_t len = strlen(in.json);
+        handler h = {};
+        value v[10];
+        int i = 0;
+        printf("-- %s (%zu bytes)\n", in.name, len);
+        bench("parse_sax", len, 10, [&] {
+            parse_sax(in.json, len, &h, nullptr);
+        });
+        bench("parse", len, 10, [&] {
+            parse(&v[i++], in.json, len);
+        });
+        bench("stringify", len, 10, [&] {
+            free(stringify(&v[0], nullptr));
+        });
+        i = 0;
+        bench("Free", len, 10, [&] {
+            Free(&v[i++]);
+        });
+    }
+    free(wide);
+    free(deep);
+}
+
+/* 大量小文档: 每次新建 context 栈 vs 复用 parser/writer */
+static void bench_reuse() {
+    const char* doc = "{\"id\":12345,\"name\":\"user_12345\",\"tags\":[\"alpha\",\"beta\\tgamma\"],\"score\":98.25,\"active\":true}";
+    size_t len = strlen(doc), n = 200000;
+    char buf[1024];
+    parser p;
+    writer w;
+    value v;
+    printf("-- %zu small documents (%zu bytes each)\n", n, len);
+    parser_init(&p, 0);
+    writer_init(&w, 0);
+    bench("parse + Free", len * n, 1, [&] {
+        for (size_t i = 0; i < n; i++) {
+            parse(&v, doc, len);
+            Free(&v);
+        }
+    });
+    bench("parse(parser) + Free", len * n, 1, [&] {
+        for (size_t i = 0; i < n; i++) {
+            parse(&p, &v, doc, len);
+            Free(&v);
+        }
+    });
+    bench("parse_arena(parser), stack buffer", len * n, 1, [&] {
+        for (size_t i = 0; i < n; i++) {
+            arena a;
+            arena_init(&a, buf, sizeof(buf));
+            parse_arena(&p, &v, doc, len, &a);
+            arena_release(&a);
+        }
+    });
+    parse(&v, doc, len);
+    bench("stringify + free", len * n, 1, [&] {
+        for (size_t i = 0; i < n; i++)
+            free(stringify(&v, nullptr));
+    });
+    bench("stringify(writer)", len * n, 1, [&] {
+        for (size_t i = 0; i < n; i++)
+            stringify(&w, &v, nullptr);
+    });
+    Free(&v);
+    parser_release(&p);
+    writer_release(&w);
+}
+
+/* JSON Lines: 每行一条 30 个字段的记录, 全部保留; 键池使每个键只保存一份 */
+static void bench_key_pool() {
+    const size_t n = 100000, fields = 30;
+    buffer b = { nullptr, 0, 0 };
+    char tmp[64];
+    size_t* lines = (size_t*)malloc((n + 1) * sizeof(size_t));
+    value* docs = (value*)malloc(n * sizeof(value));
+    size_t len, i, j;
+    for (i = 0; i < n; i++) {
+        lines[i] = b.len;
+        buffer_puts(&b, "{");
+        for (j = 0; j < fields; j++) {
+            sprintf(tmp, "%s\"field_name_%02zu\":%zu", j ? "," : "", j, i + j);
+            buffer_puts(&b, tmp);
+        }
+        buffer_puts(&b, "}\n");
+    }
+    lines[n] = b.len;
+    len = b.len;
+    printf("-- %zu records x %zu keys (%zu bytes), retained\n", n, fields, len);
+    bench("parse(parser) + Free", len, 5, [&] {
+        parser p;
+        parser_init(&p, 0);
+        for (i = 0; i < n; i++)
+            parse(&p, &docs[i], b.s + lines[i], lines[i + 1] - lines[i]);
+        for (i = 0; i < n; i++)
+            Free(&docs[i]);
+        parser_release(&p);
+    });
+    bench("parse(parser, key_pool) + Free", len, 5, [&] {
+        parser p;
+        parser_init(&p, 0);
+        p.keys = key_pool_create();
+        for (i = 0; i < n; i++)
+            parse(&p, &docs[i], b.s + lines[i], lines[i + 1] - lines[i]);
+        for (i = 0; i < n; i++)
+            Free(&docs[i]);
+        key_pool_destroy(p.keys);
+        parser_release(&p);
+    });
+    free(lines);
+    free(docs);
+    free(b.s);
+}
+
+/* NDJSON: 逐行调用 parse 与 parse_ndjson 在不同线程数下的对比 */
+static void bench_ndjson() {
+    char* records = make_ndjson(200000), *p, *q;
+    size_t len = strlen(records), n;
+    unsigned threads, cores = std::thread::hardware_concurrency();
+    ndjson_record* r;
+    printf("-- ndjson (%zu bytes)\n", len);
+    bench("parse per line, 1 thread, retained", len, 5, [&] {
+        parser ps;
+        size_t i = 0;
+        r = (ndjson_record*)malloc(200000 * sizeof(ndjson_record));
+        parser_init(&ps, 0);
+        for (p = records; p < records + len; p = q + 1) {
+            q = (char*)memchr(p, '\n', records + len - p);
+            r[i].status = parse(&ps, &r[i].v, p, q - p);
+            i++;
+        }
+        parser_release(&ps);
+        free_ndjson(r, i);
+    });
+    for (threads = 1; ; threads = threads * 2 > cores ? cores : threads * 2) {
+        char name[64];
+        sprintf(name, "parse_ndjson, %u threads", threads);
+        bench(name, len, 5, [&] {
+            parse_ndjson(records, len, &r, &n, threads);
+            free_ndjson(r, n);
+        });
+        if (threads == cores)
+            break;
+    }
+    free(records);
+}
+
+/* 很大的单个文档: parse 与两阶段的 parse_indexed */
+static void bench_indexed() {
+    char* minified = make_records(500000);
+    char* indented = make_indented(minified);
+    char* strings = make_strings(20000, 1000);
+    struct { const char* name; char* json; } inputs[] = {
+        { "records", minified }, { "indented", indented }, { "long strings", strings }
+    };
+    unsigned cores = std::thread::hardware_concurrency();
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+        const char* json = inputs[i].json;
+        size_t len = strlen(json);
+        char name[64];
+        printf("-- %s (%zu bytes)\n", inputs[i].name, len);
+        bench("parse", len, 3, [&] {
+            value v;
+            parse(&v, json, len);
+            Free(&v);
+        });
+        bench("parse_indexed, 1 thread", len, 3, [&] {
+            value v;
+            parse_indexed(&v, json, len, 1);
+            Free(&v);
+        });
+        if (cores > 1) {
+            sprintf(name, "parse_indexed, %u threads", cores);
+            bench(name, len, 3, [&] {
+                value v;
+                parse_indexed(&v, json, len, cores);
+                Free(&v);
+            });
+        }
+    }
+    free(strings);
+    free(indented);
+    free(minified);
+}
+
+/* DOM 占用的字节数 (不含 malloc 自身的开销) 与遍历 */
+static size_t dom_bytes(const value* v, size_t* blocks) {
+    size_t i, n = 0;
+    switch (get_type(v))
+    {
+    case EASYJson_STRING:
+        if (get_string_length(v) <= 22)   /* 短字符串在 value 内 */
+            return 0;
+        ++*blocks;
+        return get_string_length(v) + 1;
+    case EASYJson_ARRAY:
+        *blocks += get_array_size(v) != 0;
+        for (i = 0; i < get_array_size(v); i++)
+            n += sizeof(value) + dom_bytes(get_array_element(v, i), blocks);
+        return n;
+    case EASYJson_OBJECT:
+        *blocks += (get_object_size(v) != 0) + get_object_size(v);
+        for (i = 0; i < get_object_size(v); i++)
+            n += sizeof(member) + get_object_key_length(v, i) + 1 + dom_bytes(get_object_value(v, i), blocks);
+        return n;
+    default:
+        return 0;
+    }
+}
+
+static double dom_walk(const value* v) {
+    size_t i;
+    double sum = 0;
+    switch (get_type(v))
+    {
+    case EASYJson_NUMBER:
+        return get_number(v);
+    case EASYJson_STRING:
+        return (double)get_string_length(v);
+    case EASYJson_ARRAY:
+        for (i = 0; i < get_array_size(v); i++)
+            sum += dom_walk(get_array_element(v, i));
+        return sum;
+    case EASYJson_OBJECT:
+        for (i = 0; i < get_object_size(v); i++)
+            sum += get_object_key_length(v, i) + dom_walk(get_object_value(v, i));
+        return sum;
+    default:
+        return 0;
+    }
+}
+
+/* tape 按顺序存放, 遍历就是从头到尾扫一遍 */
+static double tape_walk(const tape* d) {
+    size_t i;
+    double sum = 0;
+    for (i = 0; i < d->size; ) {
+        type t = get_type(d, i);
+        if (t == EASYJson_NUMBER)
+            sum += get_number(d, i);
+        else if (t == EASYJson_STRING)
+            sum += get_string_length(d, i);
+        i = t >= EASYJson_ARRAY ? first_child(d, i) : next_sibling(d, i);
+    }
+    return sum;
+}
+
+static void bench_tape() {
+    char* json = make_records(200000);
+    size_t len = strlen(json), bytes, blocks = 0;
+    double s1 = 0, s2 = 0;
+    value v;
+    tape d;
+    printf("-- tape vs value tree (%zu bytes)\n", len);
+    bench("parse + Free", len, 5, [&] {
+        parse(&v, json, len);
+        Free(&v);
+    });
+    bench("parse_tape + tape_release", len, 5, [&] {
+        parse_tape(&d, json, len);
+        tape_release(&d);
+    });
+    parse(&v, json, len);
+    parse_tape(&d, json, len);
+    bytes = sizeof(value) + dom_bytes(&v, &blocks);
+    printf("memory: value tree %zu bytes in %zu blocks, tape %zu bytes in 2 blocks\n",
+           bytes, blocks, d.size * sizeof(uint64_t) + d.strings_size);
+    bench("walk value tree", len, 20, [&] { s1 += dom_walk(&v); });
+    bench("walk tape", len, 20, [&] { s2 += tape_walk(&d); });
+    if (s1 != s2)
+        printf("walk mismatch\n");
+    Free(&v);
+    tape_release(&d);
+    free(json);
+}
+
+/* 从几百个字段的文档中取 5 个字段: 完整解析与按需解析 */
+static void bench_lazy() {
+    static const char* fields[] = { "f003", "f050", "f150", "f250", "f299" };
+    buffer b = { nullptr, 0, 0 };
+    char tmp[256];
+    size_t i, len, n = 20000;
+    double sum1 = 0, sum2 = 0;
+    buffer_puts(&b, "{");
+    for (i = 0; i < 300; i++) {
+        switch (i % 4)
+        {
+        case 0: sprintf(tmp, "\"f%03zu\":%zu.5,", i, i); break;
+        case 1: sprintf(tmp, "\"f%03zu\":\"some text value number %zu with \\\"escapes\\\"\",", i, i); break;
+        case 2: sprintf(tmp, "\"f%03zu\":[1,2,3,{\"x\":true,\"y\":null},\"item\"],", i); break;
+        default: sprintf(tmp, "\"f%03zu\":{\"id\":%zu,\"name\":\"nested_%zu\",\"tags\":[\"a\",\"b\"]},", i, i, i); break;
+        }
+        buffer_puts(&b, tmp);
+    }
+    b.s[b.len - 1] = '}';
+    len = b.len;
+    printf("-- 5 of 300 fields (%zu bytes)\n", len);
+    bench("parse + find + Free", len * n, 1, [&] {
+        for (size_t k = 0; k < n; k++) {
+            value v;
+            parse(&v, b.s, len);
+            for (size_t f = 0; f < 5; f++) {
+                value* x = find_object_value(&v, fields[f], 4);
+                if (x && get_type(x) == EASYJson_NUMBER)
+                    sum1 += get_number(x);
+            }
+            Free(&v);
+        }
+    });
+    bench("parse_lazy + find + get_value", len * n, 1, [&] {
+        for (size_t k = 0; k < n; k++) {
+            lazy root, x;
+            value v;
+            parse_lazy(&root, b.s, len);
+            for (size_t f = 0; f < 5; f++) {
+                find_object_value(&root, fields[f], 4, &x);
+                if (x.json && get_type(&x) == EASYJson_NUMBER && get_value(&x, &v) == PARSE_OK)
+                    sum2 += get_number(&v);
+            }
+        }
+    });
+    bench("parse_lazy only", len * n, 1, [&] {
+        for (size_t k = 0; k < n; k++) {
+            lazy root;
+            parse_lazy(&root, b.s, len);
+        }
+    });
+    if (sum1 != sum2)
+        printf("sum mismatch\n");
+    free(b.s);
+}
+
+/* 记录中的字符串多为短字符串: 解析/释放, 以及遍历读取所有字符串 */
+static void bench_short_strings() {
+    char* json = make_records(100000);
+    size_t len = strlen(json), total = 0, inlined = 0, strings = 0;
+    value v;
+    printf("-- short strings (%zu bytes)\n", len);
+    bench("parse + Free", len, 10, [&] {
+        parse(&v, json, len);
+        Free(&v);
+    });
+    parse(&v, json, len);
+    for (size_t i = 0; i < get_array_size(&v); i++) {
+        value* r = get_array_element(&v, i);
+        for (size_t j = 0; j < get_object_size(r); j++) {
+            value* e = get_object_value(r, j);
+            if (get_type(e) == EASYJson_STRING) {
+                strings++;
+                inlined += (e->flags & FLAG_INLINE) != 0;
+            }
+        }
+    }
+    bench("read every string value", len, 10, [&] {
+        for (size_t i = 0; i < get_array_size(&v); i++) {
+            value* r = get_array_element(&v, i);
+            for (size_t j = 0; j < get_object_size(r); j++) {
+                value* e = get_object_value(r, j);
+                if (get_type(e) == EASYJson_STRING)
+                    total += get_string_length(e) + get_string(e)[0];
+            }
+        }
+    });
+    printf("%zu of %zu top-level record strings stored inline%s\n", inlined, strings, total ? "" : " ");
+    Free(&v);
+    free(json);
+}
+
+int main(int argc, char** argv) {
+    /* 可用参数选择要运行的测试, 如 ./bench depth numbers */
+    struct { const char* name; void (*run)(); } all[] = {
+        { "arena", bench_arena }, { "insitu", bench_insitu }, { "length", bench_length },
+        { "whitespace", bench_whitespace }, { "strings", bench_strings }, { "numbers", bench_numbers },
+        { "stringify_numbers", bench_stringify_numbers }, { "integers", bench_integers }, { "find", bench_find },
+        { "sax", bench_sax }, { "stream", bench_stream }, { "stringify_sink", bench_stringify_sink },
+        { "depth", bench_depth }, { "reuse", bench_reuse },
+        { "short_strings", bench_short_strings }, { "key_pool", bench_key_pool },
+        { "ndjson", bench_ndjson }, { "indexed", bench_indexed },
+        { "tape", bench_tape }, { "lazy", bench_lazy },
+        { "pointer", bench_pointer }, { "copy", bench_copy }, { "build", bench_build },
+#ifdef EASYJSON_DOCUMENT
+        { "document", bench_document }, { "parse_into", bench_parse_into },
+#endif
+    };
+    for (auto& b : all) {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; i++)
+            selected |= strcmp(argv[i], b.name) == 0;
+        if (selected)
+            b.run();
+    }
+    return 0;
+}
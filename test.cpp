@@ -28,6 +28,8 @@ static int test_pass = 0;
 #define EXPECT_EQ_DOUBLE(expect, actual) EXPECT_EQ_BASE((expect) == (actual), expect, actual, "%.17g")
 #define EXPECT_EQ_STRING(expect, actual, alength) \
     EXPECT_EQ_BASE(sizeof(expect) - 1 == alength && memcmp(expect, actual, alength) == 0, expect, actual, "%s")
+#define EXPECT_EQ_INT64(expect, actual) EXPECT_EQ_BASE((expect) == (actual), (long long)(expect), (long long)(actual), "%lld")
+#define EXPECT_EQ_UINT64(expect, actual) EXPECT_EQ_BASE((expect) == (actual), (unsigned long long)(expect), (unsigned long long)(actual), "%llu")
 #define EXPECT_TRUE(actual) EXPECT_EQ_BASE((actual) != 0, "true", "false", "%s")
 #define EXPECT_FALSE(actual) EXPECT_EQ_BASE((actual) == 0, "false", "true", "%s")
 
@@ -43,6 +45,9 @@ static int test_pass = 0;
         v.type = EASYJson_FALSE; \
         EXPECT_EQ_INT(error, parse(&v, json)); \
         EXPECT_EQ_INT(EASYJson_NULL, get_type(&v)); \
+        v.type = EASYJson_FALSE; \
+        EXPECT_EQ_INT(error, parse_indexed(&v, json, strlen(json), 1)); \
+        EXPECT_EQ_INT(EASYJson_NULL, get_type(&v)); \
     } while(0)
 
 #define TEST_NUMBER(expect, json) \
@@ -110,6 +115,22 @@ static void test_parse_number() {
     TEST_NUMBER(-2.2250738585072014e-308, "-2.2250738585072014e-308");
     TEST_NUMBER( 1.7976931348623157e+308, "1.7976931348623157e+308");  /* Max double */
     TEST_NUMBER(-1.7976931348623157e+308, "-1.7976931348623157e+308");
+
+    /* 需要正确舍入的情形 */
+    TEST_NUMBER(9007199254740992.0, "9007199254740993");  /* 2^53 + 1, 向偶数舍入 */
+    TEST_NUMBER(9007199254740996.0, "9007199254740995");
+    TEST_NUMBER(18446744073709551616.0, "18446744073709551615");
+    TEST_NUMBER(0.1, "0.1000000000000000055511151231257827021181583404541015625");
+    TEST_NUMBER(2.2250738585072011e-308, "2.2250738585072011e-308");
+    TEST_NUMBER(1.7976931348623157e+308, "1.7976931348623158e+308");
+    TEST_NUMBER(4.9406564584124654e-324, "2.4703282292062328e-324");  /* 略大于最小非规格化数的一半 */
+    TEST_NUMBER(0.0, "2.4703282292062327e-324");
+    /* 恰好位于 1 与其后继中点的 57 位数字, 以及其上下扰动 */
+    TEST_NUMBER(1.0, "1.00000000000000011102230246251565404236316680908203125");
+    TEST_NUMBER(1.0000000000000002, "1.00000000000000011102230246251565404236316680908203126");
+    TEST_NUMBER(1.0, "1.00000000000000011102230246251565404236316680908203124");
+    TEST_NUMBER(123456789012345678901234567890.0, "123456789012345678901234567890");
+    TEST_NUMBER(1.2345678901234567e-300, "0.0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000012345678901234567");
 }
 
 #define TEST_STRING(expect, json)\
@@ -172,6 +193,9 @@ static void test_parse_root_not_singular() {
 static void test_parse_number_too_big() {
     TEST_ERROR(PARSE_NUMBER_TOO_BIG, "1e309");
     TEST_ERROR(PARSE_NUMBER_TOO_BIG, "-1e309");
+    TEST_ERROR(PARSE_NUMBER_TOO_BIG, "1.7976931348623159e308");
+    TEST_ERROR(PARSE_NUMBER_TOO_BIG, "1e100000000000");
+    TEST_ERROR(PARSE_NUMBER_TOO_BIG, "179769313486231590000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000");
 }
 
 static void test_parse_missing_quotation_mark() {
@@ -370,14 +394,52 @@ static void test_stringify_number() {
     TEST_ROUNDTRIP("1.234e-20");
 
     TEST_ROUNDTRIP("1.0000000000000002"); /* the smallest number > 1 */
-    TEST_ROUNDTRIP("4.9406564584124654e-324"); /* minimum denormal */
-    TEST_ROUNDTRIP("-4.9406564584124654e-324");
-    TEST_ROUNDTRIP("2.2250738585072009e-308");  /* Max subnormal double */
-    TEST_ROUNDTRIP("-2.2250738585072009e-308");
+    TEST_ROUNDTRIP("5e-324"); /* minimum denormal */
+    TEST_ROUNDTRIP("-5e-324");
+    TEST_ROUNDTRIP("2.225073858507201e-308");  /* Max subnormal double */
+    TEST_ROUNDTRIP("-2.225073858507201e-308");
     TEST_ROUNDTRIP("2.2250738585072014e-308");  /* Min normal positive double */
     TEST_ROUNDTRIP("-2.2250738585072014e-308");
     TEST_ROUNDTRIP("1.7976931348623157e+308");  /* Max double */
     TEST_ROUNDTRIP("-1.7976931348623157e+308");
+
+    /* 最短往返表示 */
+    TEST_ROUNDTRIP("0.1");
+    TEST_ROUNDTRIP("0.3");
+    TEST_ROUNDTRIP("0.30000000000000004");
+    TEST_ROUNDTRIP("0.0001");
+    TEST_ROUNDTRIP("1e-05");
+    TEST_ROUNDTRIP("123456.789");
+    TEST_ROUNDTRIP("9007199254740991");
+    TEST_ROUNDTRIP("9007199254740992");
+    TEST_ROUNDTRIP("18014398509481984");
+    TEST_ROUNDTRIP("1e+17");
+    TEST_ROUNDTRIP("2.718316374298659e+276");
+    TEST_ROUNDTRIP("-1e+100");
+
+    /* 整数路径 */
+    TEST_ROUNDTRIP("9007199254740993");
+    TEST_ROUNDTRIP("9223372036854775807");
+    TEST_ROUNDTRIP("-9223372036854775808");
+    TEST_ROUNDTRIP("18446744073709551615");
+
+    /* 2^53 以上的整数值 double 写成科学计数法, 读回仍是同一个 double 而不是 int64 */
+    TEST_ROUNDTRIP("9.223372036857758e+16");
+    TEST_ROUNDTRIP("1.8014398509481984e+16");
+    TEST_ROUNDTRIP("1e+16");
+    {
+        value v, v2;
+        char* json;
+        size_t length;
+        init(&v);
+        set_number(&v, 92233720368577584.0);
+        json = stringify(&v, &length);
+        EXPECT_EQ_INT(PARSE_OK, parse(&v2, json, length));
+        EXPECT_FALSE(is_int64(&v2));
+        EXPECT_TRUE(is_equal(&v, &v2));
+        Free(&v2);
+        free(json);
+    }
 }
 
 static void test_stringify_string() {
@@ -398,6 +460,73 @@ static void test_stringify_object() {
     TEST_ROUNDTRIP("{\"n\":null,\"f\":false,\"t\":true,\"i\":123,\"s\":\"abc\",\"a\":[1,2,3],\"o\":{\"1\":1,\"2\":2,\"3\":3}}");
 }
 
+struct sink_log
+{
+    std::string out;
+    size_t max_chunk;
+    int fail_after;     /* 第几次调用返回 0, -1 表示不失败 */
+};
+
+static int sink_collect(void* user, const char* s, size_t len) {
+    sink_log* l = (sink_log*)user;
+    if (l->fail_after-- == 0)
+        return 0;
+    l->out.append(s, len);
+    l->max_chunk = len > l->max_chunk ? len : l->max_chunk;
+    return 1;
+}
+
+static void test_stringify_sink() {
+    char buf[64], str[1000], *expect, *read;
+    size_t i, len;
+    value v;
+    FILE* fp;
+    std::string out;
+
+    EXPECT_EQ_INT(PARSE_OK, parse(&v, "{\"a\":[1,2.5,-3,true,false,null,\"x\\n\\u0001\"],\"b\":{\"c\":[]}}"));
+    /* 长字符串, 每个字符都要转义 */
+    for (i = 0; i < sizeof(str); i++)
+        str[i] = i % 3 ? '\x01' : '"';
+    set_string(&v.u.o.m[1].v, str, sizeof(str));
+    expect = stringify(&v, &len);
+
+    for (size_t size = 64; size <= 4096; size *= 4) {
+        sink_log l = { std::string(), 0, -1 };
+        char* b = (char*)malloc(size);
+        EXPECT_EQ_INT(PARSE_OK, stringify_sink(&v, sink_collect, &l, b, size));
+        EXPECT_EQ_SIZE_T(len, l.out.size());
+        EXPECT_TRUE(l.out == expect);
+        EXPECT_TRUE(l.max_chunk <= size);
+        free(b);
+    }
+    /* 缓冲区放不下一个数字时改用内部分配的栈, 输出不变 */
+    for (size_t size = 1; size <= 16; size *= 4) {
+        sink_log l = { std::string(), 0, -1 };
+        EXPECT_EQ_INT(PARSE_OK, stringify_sink(&v, sink_collect, &l, buf, size));
+        EXPECT_TRUE(l.out == expect);
+    }
+
+    sink_log l = { std::string(), 0, 1 };
+    EXPECT_EQ_INT(PARSE_TERMINATED, stringify_sink(&v, sink_collect, &l, buf, sizeof(buf)));
+    EXPECT_EQ_SIZE_T(0, l.fail_after + 1);     /* 失败后不再调用 */
+
+    out = ">";
+    EXPECT_EQ_INT(PARSE_OK, stringify_to_string(&v, &out));
+    EXPECT_TRUE(out == std::string(">") + expect);
+
+    fp = tmpfile();
+    EXPECT_EQ_INT(PARSE_OK, stringify_fd(&v, fileno(fp)));
+    rewind(fp);
+    read = (char*)malloc(len + 1);
+    EXPECT_EQ_SIZE_T(len, fread(read, 1, len + 1, fp));
+    EXPECT_TRUE(memcmp(read, expect, len) == 0);
+    fclose(fp);
+    free(read);
+
+    free(expect);
+    Free(&v);
+}
+
 static void test_stringify() {
     TEST_ROUNDTRIP("null");
     TEST_ROUNDTRIP("false");
@@ -406,6 +535,7 @@ static void test_stringify() {
     test_stringify_string();
     test_stringify_array();
     test_stringify_object();
+    test_stringify_sink();
 }
 
 static void test_access_null() {
@@ -434,6 +564,20 @@ static void test_access_number() {
     set_string(&v, "a", 1);
     set_number(&v, 1234.5);
     EXPECT_EQ_DOUBLE(1234.5, get_number(&v));
+    set_int64(&v, -42);
+    EXPECT_TRUE(is_int64(&v));
+    EXPECT_EQ_INT64(-42, get_int64(&v));
+    EXPECT_EQ_DOUBLE(-42.0, get_number(&v));
+    set_uint64(&v, 42);
+    EXPECT_TRUE(is_int64(&v));
+    EXPECT_TRUE(is_uint64(&v));
+    EXPECT_EQ_UINT64(42, get_uint64(&v));
+    set_uint64(&v, UINT64_MAX);
+    EXPECT_FALSE(is_int64(&v));
+    EXPECT_EQ_UINT64(UINT64_MAX, get_uint64(&v));
+    EXPECT_EQ_DOUBLE(18446744073709551616.0, get_number(&v));
+    set_number(&v, 1.0);
+    EXPECT_FALSE(is_int64(&v));
     Free(&v);
 }
 
@@ -447,6 +591,1201 @@ static void test_access_string() {
     Free(&v);
 }
 
+static void test_inline_string() {
+    char s[40], json[48];
+    size_t len;
+    value v;
+    arena a;
+    init(&v);
+    for (len = 0; len < sizeof(s); len++) {
+        memset(s, 'a' + len % 26, len);
+        s[len / 2] = '\n';     /* 含转义 */
+        int inline_expected = len <= 3 * sizeof(size_t) - 2;
+
+        set_string(&v, s, len);
+        EXPECT_EQ_SIZE_T(len, get_string_length(&v));
+        EXPECT_TRUE(memcmp(get_string(&v), s, len) == 0 && get_string(&v)[len] == '\0');
+        EXPECT_EQ_INT(inline_expected, (v.flags & FLAG_INLINE) != 0);
+        /* 字符串在值内部, 随值一起移动 */
+        value w = v;
+        memset(&v, 0xCC, sizeof(v));
+        EXPECT_TRUE(memcmp(get_string(&w), s, len) == 0);
+        Free(&w);
+        init(&v);
+
+        char* p = json;
+        *p++ = '"';
+        for (size_t i = 0; i < len; i++) {
+            if (s[i] == '\n') {
+                *p++ = '\\';
+                *p++ = 'n';
+            }
+            else
+                *p++ = s[i];
+        }
+        strcpy(p, "\"");
+        EXPECT_EQ_INT(PARSE_OK, parse(&v, json));
+        EXPECT_EQ_SIZE_T(len, get_string_length(&v));
+        EXPECT_TRUE(memcmp(get_string(&v), s, len) == 0);
+        EXPECT_EQ_INT(inline_expected, (v.flags & FLAG_INLINE) != 0);
+        Free(&v);
+
+        arena_init(&a, nullptr, 0);
+        EXPECT_EQ_INT(PARSE_OK, parse_arena(&v, json, &a));
+        EXPECT_TRUE(memcmp(get_string(&v), s, len) == 0);
+        EXPECT_EQ_INT(inline_expected, (v.flags & FLAG_INLINE) != 0);
+        arena_release(&a);
+    }
+}
+
+static void test_parse_arena() {
+    static char buf[64];
+    arena a;
+    value v;
+    size_t i;
+
+    /* 调用方提供的缓冲区, 不够时由库追加块 */
+    arena_init(&a, buf, sizeof(buf));
+    EXPECT_EQ_INT(PARSE_OK, parse_arena(&v, "{\"a\":[1,\"abc\",{\"b\":null}],\"s\":\"Hello\\nWorld\"}", &a));
+    EXPECT_EQ_INT(EASYJson_OBJECT, get_type(&v));
+    EXPECT_EQ_SIZE_T(2, get_object_size(&v));
+    EXPECT_EQ_STRING("a", get_object_key(&v, 0), get_object_key_length(&v, 0));
+    EXPECT_EQ_SIZE_T(3, get_array_size(get_object_value(&v, 0)));
+    EXPECT_EQ_DOUBLE(1.0, get_number(get_array_element(get_object_value(&v, 0), 0)));
+    EXPECT_EQ_STRING("abc", get_string(get_array_element(get_object_value(&v, 0), 1)), get_string_length(get_array_element(get_object_value(&v, 0), 1)));
+    EXPECT_EQ_STRING("Hello\nWorld", get_string(get_object_value(&v, 1)), get_string_length(get_object_value(&v, 1)));
+    EXPECT_TRUE(a.chunks != NULL);
+    arena_release(&a);
+
+    /* 库自行分配 */
+    arena_init(&a, NULL, 0);
+    EXPECT_EQ_INT(PARSE_OK, parse_arena(&v, "[0,1,2,3,4,5,6,7,8,9]", &a));
+    EXPECT_EQ_SIZE_T(10, get_array_size(&v));
+    for (i = 0; i < 10; i++)
+        EXPECT_EQ_DOUBLE((double)i, get_number(get_array_element(&v, i)));
+    /* 修改 arena 中的节点不会释放 arena 内存 */
+    set_string(get_array_element(&v, 0), "x", 1);
+    Free(get_array_element(&v, 0));
+    EXPECT_EQ_INT(PARSE_MISS_COMMA_OR_CURLY_BRACKET, parse_arena(&v, "{\"a\":[\"b\"],\"c\":\"d\"", &a));
+    EXPECT_EQ_INT(EASYJson_NULL, get_type(&v));
+    arena_release(&a);
+}
+
+static void test_parse_insitu() {
+    char json[] = "{\"k\\u0041\":[\"abc\",\"Hello\\nWorld\",\"\\uD834\\uDD1E\"],\"n\":1}";
+    char bad[] = "[\"abc\",\"\\v\"]";
+    value v;
+    value* a;
+
+    EXPECT_EQ_INT(PARSE_OK, parse_insitu(&v, json));
+    EXPECT_EQ_INT(EASYJson_OBJECT, get_type(&v));
+    EXPECT_EQ_SIZE_T(2, get_object_size(&v));
+    EXPECT_EQ_STRING("kA", get_object_key(&v, 0), get_object_key_length(&v, 0));
+    EXPECT_TRUE(get_object_key(&v, 0) >= json && get_object_key(&v, 0) < json + sizeof(json));
+    a = get_object_value(&v, 0);
+    EXPECT_EQ_SIZE_T(3, get_array_size(a));
+    EXPECT_EQ_STRING("abc", get_string(get_array_element(a, 0)), get_string_length(get_array_element(a, 0)));
+    EXPECT_TRUE(get_string(get_array_element(a, 0)) > json && get_string(get_array_element(a, 0)) < json + sizeof(json));
+    EXPECT_EQ_STRING("Hello\nWorld", get_string(get_array_element(a, 1)), get_string_length(get_array_element(a, 1)));
+    EXPECT_EQ_STRING("\xF0\x9D\x84\x9E", get_string(get_array_element(a, 2)), get_string_length(get_array_element(a, 2)));
+    EXPECT_EQ_DOUBLE(1.0, get_number(get_object_value(&v, 1)));
+    Free(&v);
+
+    EXPECT_EQ_INT(PARSE_INVALID_STRING_ESCAPE, parse_insitu(&v, bad));
+    EXPECT_EQ_INT(EASYJson_NULL, get_type(&v));
+}
+
+/* 拷贝到恰好 len 字节的堆块中, 越界读取可被内存检查工具发现 */
+static int parse_exact(value* v, const char* json, size_t len) {
+    char* buf = (char*)malloc(len ? len : 1);
+    int ret;
+    memcpy(buf, json, len);
+    ret = parse(v, buf, len);
+    free(buf);
+    return ret;
+}
+
+static int parse_indexed_exact(value* v, const char* json, size_t len) {
+    char* buf = (char*)malloc(len ? len : 1);
+    int ret;
+    memcpy(buf, json, len);
+    ret = parse_indexed(v, buf, len, 1);
+    free(buf);
+    return ret;
+}
+
+#define TEST_ERROR_LEN(error, json) \
+    do { \
+        value v; \
+        v.type = EASYJson_FALSE; \
+        EXPECT_EQ_INT(error, parse_exact(&v, json, sizeof(json) - 1)); \
+        EXPECT_EQ_INT(EASYJson_NULL, get_type(&v)); \
+        v.type = EASYJson_FALSE; \
+        EXPECT_EQ_INT(error, parse_indexed_exact(&v, json, sizeof(json) - 1)); \
+        EXPECT_EQ_INT(EASYJson_NULL, get_type(&v)); \
+    } while(0)
+
+static void test_parse_length() {
+    value v;
+
+    /* 只解析前缀, 不要求 '\0' 结尾 */
+    EXPECT_EQ_INT(PARSE_OK, parse(&v, "[1,2] garbage", 5));
+    EXPECT_EQ_SIZE_T(2, get_array_size(&v));
+    Free(&v);
+    EXPECT_EQ_INT(PARSE_OK, parse(&v, "123456", 3));
+    EXPECT_EQ_DOUBLE(123.0, get_number(&v));
+    EXPECT_EQ_INT(PARSE_OK, parse_exact(&v, "-1.5e+3", 7));
+    EXPECT_EQ_DOUBLE(-1.5e+3, get_number(&v));
+    EXPECT_EQ_INT(PARSE_OK, parse_exact(&v, "true", 4));
+    EXPECT_EQ_INT(EASYJson_TRUE, get_type(&v));
+    EXPECT_EQ_INT(PARSE_OK, parse_exact(&v, "\"\\u20AC\"", 8));
+    EXPECT_EQ_STRING("\xE2\x82\xAC", get_string(&v), get_string_length(&v));
+    Free(&v);
+
+    /* 在输入末尾截断 */
+    TEST_ERROR_LEN(PARSE_EXPECT_VALUE, " ");
+    TEST_ERROR_LEN(PARSE_INVALID_VALUE, "tru");
+    TEST_ERROR_LEN(PARSE_INVALID_VALUE, "1.");
+    TEST_ERROR_LEN(PARSE_INVALID_VALUE, "1e");
+    TEST_ERROR_LEN(PARSE_INVALID_VALUE, "-");
+    TEST_ERROR_LEN(PARSE_MISS_QUOTATION_MARK, "\"abc");
+    TEST_ERROR_LEN(PARSE_INVALID_STRING_ESCAPE, "\"\\");
+    TEST_ERROR_LEN(PARSE_INVALID_UNICODE_HEX, "\"\\u12");
+    TEST_ERROR_LEN(PARSE_INVALID_UNICODE_SURROGATE, "\"\\uD834");
+    TEST_ERROR_LEN(PARSE_INVALID_UNICODE_SURROGATE, "\"\\uD834\\");
+    TEST_ERROR_LEN(PARSE_INVALID_UNICODE_HEX, "\"\\uD834\\uDD");
+    TEST_ERROR_LEN(PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "[1");
+    TEST_ERROR_LEN(PARSE_MISS_KEY, "{");
+    TEST_ERROR_LEN(PARSE_MISS_COLON, "{\"a\"");
+    TEST_ERROR_LEN(PARSE_MISS_COMMA_OR_CURLY_BRACKET, "{\"a\":1");
+
+    /* 内嵌的 '\0' */
+    TEST_ERROR_LEN(PARSE_INVALID_VALUE, "\0");
+    TEST_ERROR_LEN(PARSE_ROOT_NOT_SINGULAR, "null\0");
+    TEST_ERROR_LEN(PARSE_INVALID_STRING_CHAR, "\"a\0b\"");
+    TEST_ERROR_LEN(PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "[1\0]");
+    TEST_ERROR_LEN(PARSE_INVALID_VALUE, "[\0]");
+}
+
+/* 在静态初始化阶段解析: 此时 EasyJson.cpp 的静态变量可能还没有动态初始化 */
+static size_t parse_at_static_init() {
+    value v;
+    size_t n = 0;
+    if (parse(&v, "[                                  \"a string longer than one SIMD block\"]") == PARSE_OK)
+        n = get_string_length(get_array_element(&v, 0));
+    Free(&v);
+    return n;
+}
+
+static const size_t static_init_length = parse_at_static_init();
+
+static void test_parse_whitespace() {
+    static const char ws[] = " \t\r\n";
+    char json[512];
+    size_t i, n;
+    value v;
+
+    /* 各种长度的空白, 覆盖向量化扫描的块边界与尾部 */
+    for (n = 0; n < 70; n++) {
+        char* p = json;
+        *p++ = '[';
+        for (i = 0; i < n; i++) *p++ = ws[i % 4];
+        *p++ = '1';
+        for (i = 0; i < n; i++) *p++ = ws[(i + 1) % 4];
+        *p++ = ',';
+        for (i = 0; i < n; i++) *p++ = ' ';
+        *p++ = '2';
+        *p++ = ']';
+        for (i = 0; i < n; i++) *p++ = '\n';
+        EXPECT_EQ_INT(PARSE_OK, parse(&v, json, p - json));
+        EXPECT_EQ_SIZE_T(2, get_array_size(&v));
+        Free(&v);
+        *p++ = 'x';
+        *p = '\0';
+        TEST_ERROR(PARSE_ROOT_NOT_SINGULAR, json);
+    }
+    EXPECT_EQ_SIZE_T(35, static_init_length);
+}
+
+static void test_parse_long_string() {
+    char json[256], insitu[256], expect[256];
+    size_t i, n;
+    value v;
+
+    /* 转义/结尾引号/控制字符出现在块扫描的不同位置 */
+    for (n = 0; n < 70; n++) {
+        for (i = 0; i < n; i++)
+            expect[i] = json[i + 1] = 'a' + i % 26;
+        json[0] = '"';
+        memcpy(json + n + 1, "\\n", 2);
+        expect[n] = '\n';
+        for (i = 0; i < n; i++)
+            expect[n + 1 + i] = json[n + 3 + i] = 'A' + i % 26;
+        memcpy(json + 2 * n + 3, "\"", 2);
+
+        EXPECT_EQ_INT(PARSE_OK, parse(&v, json));
+        EXPECT_EQ_SIZE_T(2 * n + 1, get_string_length(&v));
+        EXPECT_TRUE(memcmp(expect, get_string(&v), 2 * n + 1) == 0);
+        Free(&v);
+
+        memcpy(insitu, json, sizeof(json));
+        EXPECT_EQ_INT(PARSE_OK, parse_insitu(&v, insitu));
+        EXPECT_EQ_SIZE_T(2 * n + 1, get_string_length(&v));
+        EXPECT_TRUE(memcmp(expect, get_string(&v), 2 * n + 1) == 0);
+        Free(&v);
+
+        json[2 * n + 3] = '\0';
+        TEST_ERROR(PARSE_MISS_QUOTATION_MARK, json);
+        json[n + 1] = '\x1F';
+        TEST_ERROR(PARSE_INVALID_STRING_CHAR, json);
+    }
+}
+
+#define TEST_INT64(expect, json) \
+    do { \
+        value v; \
+        EXPECT_EQ_INT(PARSE_OK, parse(&v, json)); \
+        EXPECT_TRUE(is_int64(&v)); \
+        EXPECT_EQ_INT64(expect, get_int64(&v)); \
+    } while(0)
+
+#define TEST_UINT64(expect, json) \
+    do { \
+        value v; \
+        EXPECT_EQ_INT(PARSE_OK, parse(&v, json)); \
+        EXPECT_FALSE(is_int64(&v)); \
+        EXPECT_TRUE(is_uint64(&v)); \
+        EXPECT_EQ_UINT64(expect, get_uint64(&v)); \
+    } while(0)
+
+static void test_parse_int64() {
+    value v;
+    TEST_INT64(0, "0");
+    TEST_INT64(1, "1");
+    TEST_INT64(-1, "-1");
+    TEST_INT64(9007199254740993LL, "9007199254740993"); /* 2^53 + 1, double 无法表示 */
+    TEST_INT64(-9007199254740993LL, "-9007199254740993");
+    TEST_INT64(INT64_MAX, "9223372036854775807");
+    TEST_INT64(INT64_MIN, "-9223372036854775808");
+    TEST_UINT64(9223372036854775808ULL, "9223372036854775808");
+    TEST_UINT64(UINT64_MAX, "18446744073709551615");
+
+    /* 含小数点/指数、-0 以及超出范围的整数仍为 double */
+    const char* doubles[] = { "-0", "1.0", "1e2", "10E0", "18446744073709551616", "-9223372036854775809", "123456789012345678901" };
+    for (size_t i = 0; i < sizeof(doubles) / sizeof(doubles[0]); i++) {
+        EXPECT_EQ_INT(PARSE_OK, parse(&v, doubles[i]));
+        EXPECT_EQ_INT(EASYJson_NUMBER, get_type(&v));
+        EXPECT_FALSE(is_int64(&v));
+        EXPECT_FALSE(is_uint64(&v));
+    }
+    TEST_NUMBER(18446744073709551616.0, "18446744073709551616");
+    TEST_NUMBER(9007199254740993.0, "9007199254740993");
+}
+
+static void test_access_array() {
+    value a, e;
+    size_t i, j;
+
+    init(&a);
+    for (j = 0; j <= 5; j += 5) {
+        set_array(&a, j);
+        EXPECT_EQ_SIZE_T(0, get_array_size(&a));
+        EXPECT_EQ_SIZE_T(j, get_array_capacity(&a));
+        for (i = 0; i < 10; i++) {
+            init(&e);
+            set_number(&e, (double)i);
+            move(pushback_array_element(&a), &e);
+            Free(&e);
+        }
+        EXPECT_EQ_SIZE_T(10, get_array_size(&a));
+        for (i = 0; i < 10; i++)
+            EXPECT_EQ_DOUBLE((double)i, get_number(get_array_element(&a, i)));
+    }
+
+    popback_array_element(&a);
+    EXPECT_EQ_SIZE_T(9, get_array_size(&a));
+    for (i = 0; i < 9; i++)
+        EXPECT_EQ_DOUBLE((double)i, get_number(get_array_element(&a, i)));
+
+    erase_array_element(&a, 4, 0);
+    EXPECT_EQ_SIZE_T(9, get_array_size(&a));
+    erase_array_element(&a, 8, 1);
+    EXPECT_EQ_SIZE_T(8, get_array_size(&a));
+    erase_array_element(&a, 0, 2);
+    EXPECT_EQ_SIZE_T(6, get_array_size(&a));
+    for (i = 0; i < 6; i++)
+        EXPECT_EQ_DOUBLE((double)i + 2, get_number(get_array_element(&a, i)));
+
+    for (i = 0; i < 2; i++)
+        set_number(insert_array_element(&a, i), (double)i);
+    EXPECT_EQ_SIZE_T(8, get_array_size(&a));
+    for (i = 0; i < 8; i++)
+        EXPECT_EQ_DOUBLE((double)i, get_number(get_array_element(&a, i)));
+
+    EXPECT_TRUE(get_array_capacity(&a) > 8);
+    shrink_array(&a);
+    EXPECT_EQ_SIZE_T(8, get_array_capacity(&a));
+    EXPECT_EQ_SIZE_T(8, get_array_size(&a));
+    for (i = 0; i < 8; i++)
+        EXPECT_EQ_DOUBLE((double)i, get_number(get_array_element(&a, i)));
+
+    set_string(&e, "Hello", 5);
+    move(pushback_array_element(&a), &e);     /* 容量已满时追加 */
+    Free(&e);
+
+    i = get_array_capacity(&a);
+    clear_array(&a);
+    EXPECT_EQ_SIZE_T(0, get_array_size(&a));
+    EXPECT_EQ_SIZE_T(i, get_array_capacity(&a));
+    shrink_array(&a);
+    EXPECT_EQ_SIZE_T(0, get_array_capacity(&a));
+
+    /* 解析得到的数组容量等于大小, 可以直接增删 */
+    EXPECT_EQ_INT(PARSE_OK, parse(&a, "[1,[2],\"a string that is not inline\"]"));
+    EXPECT_EQ_SIZE_T(3, get_array_capacity(&a));
+    set_number(pushback_array_element(&a), 4);
+    erase_array_element(&a, 1, 2);
+    EXPECT_EQ_SIZE_T(2, get_array_size(&a));
+    EXPECT_EQ_DOUBLE(4.0, get_number(get_array_element(&a, 1)));
+    Free(&a);
+}
+
+static void test_access_object() {
+    value o, v, *pv;
+    size_t i, j, index;
+    arena ar;
+
+    init(&o);
+    for (j = 0; j <= 5; j += 5) {
+        set_object(&o, j);
+        EXPECT_EQ_SIZE_T(0, get_object_size(&o));
+        EXPECT_EQ_SIZE_T(j, get_object_capacity(&o));
+        for (i = 0; i < 10; i++) {
+            char key[2] = "a";
+            key[0] += (char)i;
+            init(&v);
+            set_number(&v, (double)i);
+            move(set_object_value(&o, key, 1), &v);
+            Free(&v);
+        }
+        EXPECT_EQ_SIZE_T(10, get_object_size(&o));
+        for (i = 0; i < 10; i++) {
+            char key[] = "a";
+            key[0] += (char)i;
+            index = find_object_index(&o, key, 1);
+            EXPECT_TRUE(index != KEY_NOT_EXIST);
+            pv = get_object_value(&o, index);
+            EXPECT_EQ_DOUBLE((double)i, get_number(pv));
+        }
+    }
+
+    /* 已有的键返回原来的值 */
+    index = find_object_index(&o, "j", 1);
+    EXPECT_TRUE(index != KEY_NOT_EXIST);
+    EXPECT_TRUE(set_object_value(&o, "j", 1) == get_object_value(&o, index));
+    remove_object_value(&o, index);
+    EXPECT_TRUE(find_object_index(&o, "j", 1) == KEY_NOT_EXIST);
+    EXPECT_EQ_SIZE_T(9, get_object_size(&o));
+
+    index = find_object_index(&o, "a", 1);
+    EXPECT_TRUE(index != KEY_NOT_EXIST);
+    remove_object_value(&o, index);
+    EXPECT_TRUE(find_object_index(&o, "a", 1) == KEY_NOT_EXIST);
+    EXPECT_EQ_SIZE_T(8, get_object_size(&o));
+
+    EXPECT_TRUE(get_object_capacity(&o) > 8);
+    shrink_object(&o);
+    EXPECT_EQ_SIZE_T(8, get_object_capacity(&o));
+    EXPECT_EQ_SIZE_T(8, get_object_size(&o));
+    for (i = 0; i < 8; i++) {
+        char key[] = "a";
+        key[0] += (char)(i + 1);
+        EXPECT_EQ_DOUBLE((double)(i + 1), get_number(get_object_value(&o, find_object_index(&o, key, 1))));
+    }
+
+    set_string(&v, "Hello", 5);
+    move(set_object_value(&o, "World", 5), &v);   /* 容量已满时添加 */
+    Free(&v);
+
+    pv = find_object_value(&o, "World", 5);
+    EXPECT_TRUE(pv != NULL);
+    EXPECT_EQ_STRING("Hello", get_string(pv), get_string_length(pv));
+
+    i = get_object_capacity(&o);
+    clear_object(&o);
+    EXPECT_EQ_SIZE_T(0, get_object_size(&o));
+    EXPECT_EQ_SIZE_T(i, get_object_capacity(&o));
+    shrink_object(&o);
+    EXPECT_EQ_SIZE_T(0, get_object_capacity(&o));
+
+    /* 成员多时边添加边查找, 索引随之更新 */
+    for (i = 0; i < 1000; i++) {
+        char key[16];
+        size_t n = (size_t)sprintf(key, "k%zu", i);
+        set_number(set_object_value(&o, key, n), (double)i);
+        EXPECT_EQ_DOUBLE((double)i, get_number(find_object_value(&o, key, n)));
+    }
+    for (i = 0; i < 1000; i += 37) {
+        char key[16];
+        size_t n = (size_t)sprintf(key, "k%zu", i);
+        EXPECT_EQ_DOUBLE((double)i, get_number(find_object_value(&o, key, n)));
+    }
+    Free(&o);
+
+    /* arena 中的对象: 成员数组与键在添加时复制到堆上 */
+    arena_init(&ar, NULL, 0);
+    EXPECT_EQ_INT(PARSE_OK, parse_arena(&o, "{\"a\":1,\"b\":[2]}", &ar));
+    EXPECT_EQ_SIZE_T(2, get_object_capacity(&o));
+    set_boolean(set_object_value(&o, "c", 1), 1);
+    remove_object_value(&o, 0);
+    pv = find_object_value(&o, "b", 1);
+    set_number(pushback_array_element(pv), 3);
+    arena_release(&ar);
+    EXPECT_EQ_SIZE_T(2, get_object_size(&o));
+    EXPECT_EQ_STRING("b", get_object_key(&o, 0), 1);
+    EXPECT_TRUE(get_boolean(find_object_value(&o, "c", 1)));
+    EXPECT_EQ_DOUBLE(3.0, get_number(get_array_element(pv, 1)));
+    Free(&o);
+}
+
+static void test_find_object() {
+    char json[2048], key[16];
+    size_t n, i, klen;
+    value v;
+    for (n = 0; n <= 40; n += n < 10 ? 1 : 10) {
+        char* p = json;
+        *p++ = '{';
+        for (i = 0; i < n; i++)
+            p += sprintf(p, "%s\"k%zu\":%zu", i ? "," : "", i, i);
+        strcpy(p, "}");
+        EXPECT_EQ_INT(PARSE_OK, parse(&v, json));
+        for (i = 0; i < n; i++) {
+            klen = sprintf(key, "k%zu", i);
+            EXPECT_EQ_SIZE_T(i, find_object_index(&v, key, klen));
+            EXPECT_EQ_DOUBLE((double)i, get_number(find_object_value(&v, key, klen)));
+        }
+        EXPECT_EQ_SIZE_T(KEY_NOT_EXIST, find_object_index(&v, "k", 1));
+        EXPECT_EQ_SIZE_T(KEY_NOT_EXIST, find_object_index(&v, "k1\0", 3));
+        EXPECT_TRUE(find_object_value(&v, "x", 1) == nullptr);
+        Free(&v);
+    }
+
+    /* arena 中的对象顺序查找 */
+    arena a;
+    arena_init(&a, nullptr, 0);
+    EXPECT_EQ_INT(PARSE_OK, parse_arena(&v, json, &a));
+    EXPECT_EQ_SIZE_T(39, find_object_index(&v, "k39", 3));
+    EXPECT_TRUE(v.u.o.index == nullptr);
+    arena_release(&a);
+
+    /* 重复键返回第一个 */
+    EXPECT_EQ_INT(PARSE_OK, parse(&v, "{\"a\":1,\"b\":2,\"c\":3,\"d\":4,\"e\":5,\"f\":6,\"g\":7,\"h\":8,\"a\":9,\"i\":10}"));
+    EXPECT_EQ_DOUBLE(1.0, get_number(find_object_value(&v, "a", 1)));
+    EXPECT_EQ_DOUBLE(10.0, get_number(find_object_value(&v, "i", 1)));
+
+    /* 改写成员后索引失效 */
+    v.u.o.size--;
+    EXPECT_TRUE(find_object_value(&v, "i", 1) == nullptr);
+    v.u.o.size++;
+    v.u.o.m[0].k[0] = 'z';
+    reset_object_index(&v);
+    EXPECT_EQ_SIZE_T(0, find_object_index(&v, "z", 1));
+    EXPECT_EQ_SIZE_T(8, find_object_index(&v, "a", 1));
+    Free(&v);
+}
+
+static void test_pointer() {
+    static const char* json = "{\"foo\":[\"bar\",\"baz\"],\"\":0,\"a/b\":1,\"c%d\":2,\"e^f\":3,\"g|h\":4,\"i\\\\j\":5,"
+        "\"k\\\"l\":6,\" \":7,\"m~n\":8,\"01\":9,\"x\":{\"y\":[null,{\"z\":true}]}}";
+    static const char* paths[] = { "/a~1b", "/c%d", "/e^f", "/g|h", "/i\\j", "/k\"l", "/ ", "/m~0n" };
+    value v, x, y;
+    pointer p, q;
+    arena a;
+    size_t i;
+
+    init(&x);
+
+    EXPECT_EQ_INT(PARSE_OK, parse(&v, json));
+    /* RFC 6901 第 5 节的例子 */
+    EXPECT_TRUE(get_by_pointer(&v, "", 0) == &v);
+    EXPECT_EQ_SIZE_T(2, get_array_size(get_by_pointer(&v, "/foo", 4)));
+    EXPECT_EQ_STRING("bar", get_string(get_by_pointer(&v, "/foo/0", 6)), 3);
+    EXPECT_EQ_DOUBLE(0.0, get_number(get_by_pointer(&v, "/", 1)));
+    for (i = 0; i < 8; i++)
+        EXPECT_EQ_DOUBLE((double)(i + 1), get_number(get_by_pointer(&v, paths[i], strlen(paths[i]))));
+    EXPECT_EQ_DOUBLE(9.0, get_number(get_by_pointer(&v, "/01", 3)));
+
+    /* 数组下标: 不允许前导 0、"-" 和越界 */
+    EXPECT_TRUE(get_by_pointer(&v, "/foo/01", 7) == nullptr);
+    EXPECT_TRUE(get_by_pointer(&v, "/foo/-", 6) == nullptr);
+    EXPECT_TRUE(get_by_pointer(&v, "/foo/2", 6) == nullptr);
+    EXPECT_TRUE(get_by_pointer(&v, "/foo/0/x", 8) == nullptr);
+    EXPECT_TRUE(get_by_pointer(&v, "/none", 5) == nullptr);
+    EXPECT_TRUE(get_by_pointer(&v, "foo", 3) == nullptr);
+
+    /* 编译结果 */
+    EXPECT_EQ_INT(POINTER_OK, compile_pointer(&p, "/x/y/1/z", 8));
+    EXPECT_EQ_SIZE_T(4, p.count);
+    EXPECT_EQ_STRING("y", p.tokens[1].key, p.tokens[1].len);
+    EXPECT_EQ_SIZE_T(POINTER_NO_INDEX, p.tokens[1].index);
+    EXPECT_EQ_SIZE_T(1, p.tokens[2].index);
+    EXPECT_TRUE(get_boolean(get_by_pointer(&v, &p)));
+    EXPECT_EQ_INT(POINTER_OK, compile_pointer(&q, "/m~0n/~1/-", 10));
+    EXPECT_EQ_STRING("m~n", q.tokens[0].key, q.tokens[0].len);
+    EXPECT_EQ_STRING("/", q.tokens[1].key, q.tokens[1].len);
+    EXPECT_EQ_SIZE_T(POINTER_END, q.tokens[2].index);
+    pointer_release(&q);
+    EXPECT_EQ_INT(POINTER_INVALID_SYNTAX, compile_pointer(&q, "a", 1));
+    EXPECT_EQ_INT(POINTER_INVALID_SYNTAX, compile_pointer(&q, "/a~2", 4));
+    EXPECT_EQ_INT(POINTER_INVALID_SYNTAX, compile_pointer(&q, "/a~", 3));
+    EXPECT_TRUE(q.tokens == nullptr && q.count == 0);
+
+    /* 替换、添加成员与追加元素 */
+    set_string(&x, "new", 3);
+    EXPECT_EQ_INT(POINTER_OK, set_by_pointer(&v, &p, &x));
+    EXPECT_EQ_INT(EASYJson_NULL, get_type(&x));
+    EXPECT_EQ_STRING("new", get_string(get_by_pointer(&v, &p)), 3);
+    set_number(&x, 1.5);
+    EXPECT_EQ_INT(POINTER_OK, set_by_pointer(&v, "/x/y/-", 6, &x));
+    set_boolean(&x, 1);
+    EXPECT_EQ_INT(POINTER_OK, set_by_pointer(&v, "/x/y/3", 6, &x));
+    EXPECT_EQ_SIZE_T(4, get_array_size(get_by_pointer(&v, "/x/y", 4)));
+    EXPECT_EQ_DOUBLE(1.5, get_number(get_by_pointer(&v, "/x/y/2", 6)));
+    EXPECT_EQ_INT(POINTER_NOT_FOUND, set_by_pointer(&v, "/x/y/5", 6, &x));
+    EXPECT_EQ_INT(POINTER_OK, set_by_pointer(&v, "/x/w~1v", 7, &x));
+    EXPECT_EQ_SIZE_T(2, get_object_size(get_by_pointer(&v, "/x", 2)));
+    EXPECT_EQ_STRING("w/v", get_object_key(get_by_pointer(&v, "/x", 2), 1), 3);
+    EXPECT_EQ_INT(POINTER_NOT_FOUND, set_by_pointer(&v, "/none/a", 7, &x));
+    EXPECT_EQ_INT(POINTER_NOT_FOUND, set_by_pointer(&v, "/01/a", 5, &x));
+    /* 成员多于索引阈值的对象, 添加后仍可按键找到 */
+    for (i = 0; i < 20; i++) {
+        char path[16];
+        size_t n = (size_t)sprintf(path, "/k%zu", i);
+        set_number(&x, (double)i);
+        EXPECT_EQ_INT(POINTER_OK, set_by_pointer(&v, path, n, &x));
+        EXPECT_EQ_DOUBLE((double)i, get_number(get_by_pointer(&v, path, n)));
+    }
+    EXPECT_EQ_DOUBLE(8.0, get_number(get_by_pointer(&v, "/m~0n", 5)));
+    pointer_release(&p);
+
+    /* 空指针替换整个文档 */
+    set_number(&x, 2.0);
+    EXPECT_EQ_INT(POINTER_OK, set_by_pointer(&v, "", 0, &x));
+    EXPECT_EQ_DOUBLE(2.0, get_number(&v));
+    Free(&v);
+
+    /* arena 中的容器与不归对象所有的键: 替换原地进行, 追加时改为在堆上分配 */
+    arena_init(&a, NULL, 0);
+    EXPECT_EQ_INT(PARSE_OK, parse_arena(&v, "{\"a\":[1],\"k\":\"v\"}", &a));
+    init(&y);
+    set_string(&y, "a string that is too long to be inline", 38);
+    EXPECT_EQ_INT(POINTER_OK, set_by_pointer(&v, "/a/0", 4, &y));
+    set_number(&y, 2.0);
+    EXPECT_EQ_INT(POINTER_OK, set_by_pointer(&v, "/a/-", 4, &y));
+    set_number(&y, 3.0);
+    EXPECT_EQ_INT(POINTER_OK, set_by_pointer(&v, "/b", 2, &y));
+    EXPECT_EQ_INT(EASYJson_NULL, get_type(&y));
+    EXPECT_EQ_SIZE_T(38, get_string_length(get_by_pointer(&v, "/a/0", 4)));
+    EXPECT_EQ_DOUBLE(2.0, get_number(get_by_pointer(&v, "/a/1", 4)));
+    EXPECT_EQ_DOUBLE(3.0, get_number(get_by_pointer(&v, "/b", 2)));
+    EXPECT_EQ_STRING("v", get_string(get_by_pointer(&v, "/k", 2)), 1);
+    Free(&v);
+    arena_release(&a);
+    {
+        char buf[] = "{\"a\":1,\"c\":[]}";
+        EXPECT_EQ_INT(PARSE_OK, parse_insitu(&v, buf));
+        EXPECT_EQ_INT(POINTER_OK, set_by_pointer(&v, "/a", 2, &y));
+        EXPECT_EQ_INT(EASYJson_NULL, get_type(get_by_pointer(&v, "/a", 2)));
+        set_number(&y, 4.0);
+        EXPECT_EQ_INT(POINTER_OK, set_by_pointer(&v, "/b", 2, &y));
+        set_boolean(&y, 1);
+        EXPECT_EQ_INT(POINTER_OK, set_by_pointer(&v, "/c/0", 4, &y));
+        memset(buf, 'x', sizeof(buf) - 1);    /* 键已复制, 不再依赖输入缓冲区 */
+        EXPECT_EQ_SIZE_T(3, get_object_size(&v));
+        EXPECT_EQ_DOUBLE(4.0, get_number(get_by_pointer(&v, "/b", 2)));
+        EXPECT_EQ_INT(EASYJson_TRUE, get_type(get_by_pointer(&v, "/c/0", 4)));
+        EXPECT_EQ_STRING("c", get_object_key(&v, 1), 1);
+        Free(&v);
+    }
+
+    /* v 在树中: 目标的子节点, 或追加时会被搬走的兄弟元素 */
+    EXPECT_EQ_INT(PARSE_OK, parse(&v, "[{\"a\":{\"b\":[1,\"a string that is too long to be inline\"]}}]"));
+    EXPECT_EQ_INT(POINTER_OK, set_by_pointer(&v, "", 0, get_by_pointer(&v, "/0/a", 4)));
+    EXPECT_EQ_INT(EASYJson_OBJECT, get_type(&v));
+    EXPECT_EQ_SIZE_T(38, get_string_length(get_by_pointer(&v, "/b/1", 4)));
+    Free(&v);
+    EXPECT_EQ_INT(PARSE_OK, parse(&v, "[\"a string that is too long to be inline\",2]"));
+    EXPECT_EQ_SIZE_T(2, get_array_capacity(&v));
+    EXPECT_EQ_INT(POINTER_OK, set_by_pointer(&v, "/-", 2, get_array_element(&v, 0)));
+    EXPECT_EQ_SIZE_T(3, get_array_size(&v));
+    EXPECT_EQ_INT(EASYJson_NULL, get_type(get_by_pointer(&v, "/0", 2)));
+    EXPECT_EQ_SIZE_T(38, get_string_length(get_by_pointer(&v, "/2", 2)));
+    /* 失败时 *v 不变 */
+    EXPECT_EQ_INT(POINTER_NOT_FOUND, set_by_pointer(&v, "/5", 2, get_array_element(&v, 2)));
+    EXPECT_EQ_INT(POINTER_NOT_FOUND, set_by_pointer(&v, "/1/x", 4, get_array_element(&v, 2)));
+    EXPECT_EQ_SIZE_T(38, get_string_length(get_by_pointer(&v, "/2", 2)));
+    Free(&v);
+}
+
+/* 把事件记录成文本, 用于检查 SAX 回调的顺序与内容 */
+struct sax_log
+{
+    char buf[512];
+    size_t len;
+    int stop_at;    /* 第几个事件返回 0, -1 表示不中止 */
+};
+
+static int sax_put(void* user, const char* s, size_t len) {
+    sax_log* l = (sax_log*)user;
+    memcpy(l->buf + l->len, s, len);
+    l->len += len;
+    l->buf[l->len++] = ' ';
+    l->buf[l->len] = '\0';
+    return l->stop_at-- != 0;
+}
+static int sax_null(void* u) { return sax_put(u, "null", 4); }
+static int sax_boolean(void* u, int b) { return b ? sax_put(u, "true", 4) : sax_put(u, "false", 5); }
+static int sax_number(void* u, double n) { char t[32]; return sax_put(u, t, sprintf(t, "%g", n)); }
+static int sax_int64(void* u, int64_t i) { char t[32]; return sax_put(u, t, sprintf(t, "i%lld", (long long)i)); }
+static int sax_string(void* u, const char* s, size_t len) { return sax_put(u, s, len); }
+static int sax_start_object(void* u) { return sax_put(u, "{", 1); }
+static int sax_key(void* u, const char* s, size_t len) { sax_put(u, s, len); return sax_put(u, ":", 1); }
+static int sax_end_object(void* u, size_t n) { char t[32]; return sax_put(u, t, sprintf(t, "}%zu", n)); }
+static int sax_start_array(void* u) { return sax_put(u, "[", 1); }
+static int sax_end_array(void* u, size_t n) { char t[32]; return sax_put(u, t, sprintf(t, "]%zu", n)); }
+
+static void test_parse_sax() {
+    handler h = { sax_null, sax_boolean, sax_number, sax_int64, nullptr, sax_string,
+                  sax_start_object, sax_key, sax_end_object, sax_start_array, sax_end_array };
+    sax_log l;
+
+    l.len = 0; l.stop_at = -1;
+    EXPECT_EQ_INT(PARSE_OK, parse_sax(" { \"a\" : [ null , true , false , 1.5 , -3 , \"x\\ty\" , [ ] , { } ] , \"b\\u00e9\" : 18446744073709551615 } ", &h, &l));
+    EXPECT_EQ_STRING("{ a : [ null true false 1.5 i-3 x\ty [ ]0 { }0 ]8 b\xC3\xA9 : 1.84467e+19 }2 ", l.buf, l.len);
+
+    /* 未设置的回调忽略对应事件 */
+    handler only_keys = {};
+    only_keys.key = sax_string;
+    l.len = 0; l.stop_at = -1;
+    EXPECT_EQ_INT(PARSE_OK, parse_sax("{\"a\":{\"b\":1},\"c\":[2]}", &only_keys, &l));
+    EXPECT_EQ_STRING("a b c ", l.buf, l.len);
+
+    /* 回调返回 0 时中止 */
+    l.len = 0; l.stop_at = 2;
+    EXPECT_EQ_INT(PARSE_TERMINATED, parse_sax("[1,2,3,4]", &h, &l));
+    EXPECT_EQ_STRING("[ i1 i2 ", l.buf, l.len);
+
+    /* 语法错误与 DOM 解析一致 */
+    l.len = 0; l.stop_at = -1;
+    EXPECT_EQ_INT(PARSE_MISS_COMMA_OR_CURLY_BRACKET, parse_sax("{\"a\":1 2}", &h, &l));
+    EXPECT_EQ_INT(PARSE_MISS_KEY, parse_sax("{1:1}", &h, &l));
+    EXPECT_EQ_INT(PARSE_ROOT_NOT_SINGULAR, parse_sax("[] x", &h, &l));
+    EXPECT_EQ_INT(PARSE_EXPECT_VALUE, parse_sax("", 0, &h, &l));
+    EXPECT_EQ_INT(PARSE_INVALID_STRING_ESCAPE, parse_sax("[\"\\v\"]", &h, &l));
+}
+
+/* 在每个位置切分以及逐字节输入, 结果须与一次性 parse 相同 */
+static void test_stream_one(stream_parser* sp, const char* json) {
+    size_t len = strlen(json), i, split;
+    value expect, v;
+    int ret = parse(&expect, json, len);
+    char* s1 = ret == PARSE_OK ? stringify(&expect, nullptr) : nullptr;
+    for (split = 0; split <= len + 1; split++) {
+        if (split <= len) {
+            feed(sp, json, split);
+            feed(sp, json + split, len - split);
+        }
+        else
+            for (i = 0; i < len; i++)
+                feed(sp, json + i, 1);
+        EXPECT_EQ_INT(ret, finish(sp, &v));
+        if (ret == PARSE_OK) {
+            char* s2 = stringify(&v, nullptr);
+            EXPECT_EQ_BASE(strcmp(s1, s2) == 0, s1, s2, "%s");
+            free(s2);
+        }
+        else
+            EXPECT_EQ_INT(EASYJson_NULL, get_type(&v));
+        Free(&v);
+    }
+    free(s1);
+    Free(&expect);
+}
+
+static void test_stream_parser() {
+    static const char* cases[] = {
+        "null", " true ", "false", "123", "-0.5e-3", "1.7976931348623157e+308", "18446744073709551615",
+        "\"\"", "\"Hello\\nWorld\"", "\"\\\\ \\\" \\u20AC \\uD834\\uDD1E\"", "\"\xE2\x82\xAC\"",
+        "[]", "[ 1 , [ 2, [ ] ] , \"a\\tb\" ]", "{}", " { \"k\\u0041\" : { \"x\" : [ null, {} ] } , \"n\" : -1E+2 } ",
+        "{\"a\":1,\"b\":[true,false,{\"c\":\"d\"}],\"e\":{}}",
+        /* 错误 */
+        "", " ", "nul", "nulL", "tru", "?", "[1,]", "[1 2]", "[1", "[", "{", "{\"a\"", "{\"a\":", "{\"a\":1",
+        "{\"a\" 1}", "{1:2}", "{\"a\":1,}", "[\"abc", "\"\\v\"", "\"\\u12\"", "\"\\uD800\"", "\"a\x01\"",
+        "1 2", "[] x", "[1e309]", "01", "1.", "-", "[1-2]", "{\"a\":[1,{\"b\":\"x\" ]}"
+    };
+    stream_parser* sp = stream_parser_create();
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+        test_stream_one(sp, cases[i]);
+
+    /* 未 finish 就销毁 */
+    feed(sp, "{\"a\":[1,{\"b", 12);
+    stream_parser_destroy(sp);
+}
+
+/* 与 parse 的结果比较; 前面加 0..pads-1 个空格, 让各处落在 64 字节块的不同位置 */
+static void test_indexed_one(const char* json, size_t pads, unsigned threads) {
+    size_t len = strlen(json), pad;
+    char* buf = (char*)malloc(len + pads);
+    value expect, v;
+    int ret, same;
+    char* s1, *s2;
+    for (pad = 0; pad < pads; pad++) {
+        memset(buf, ' ', pad);
+        memcpy(buf + pad, json, len);
+        ret = parse(&expect, buf, pad + len);
+        EXPECT_EQ_INT(ret, parse_indexed(&v, buf, pad + len, threads));
+        if (ret == PARSE_OK) {
+            s1 = stringify(&expect, nullptr);
+            s2 = stringify(&v, nullptr);
+            same = strcmp(s1, s2) == 0;
+            EXPECT_TRUE(same);
+            free(s1);
+            free(s2);
+        }
+        else
+            EXPECT_EQ_INT(EASYJson_NULL, get_type(&v));
+        Free(&v);
+        Free(&expect);
+    }
+    free(buf);
+}
+
+static void test_parse_indexed() {
+    static const char* cases[] = {
+        "null", "true", "false", "123", "-0.5e-3", "18446744073709551615", "\"\"", "\"Hello\\nWorld\"",
+        "\"\\\\\"", "\"\\\\\\\\\"", "\"\\\"\\\\\"", "\"a\\\\\\\"b\"", "\"\\uD834\\uDD1E\"",
+        "[]", "{}", "[ 1 , [ 2, [ ] ] , \"a\\tb\" ]", " { \"k\\u0041\" : { \"x\" : [ null, {} ] } , \"n\" : -1E+2 } \r\n",
+        "{\"a\":1,\"b\":[true,false,{\"c\":\"d\"}],\"e\":{},\"\\\"\":\"\\\\\"}",
+        "[\"0123456789012345678901234567890123456789012345678901234567890123456789\",\"x\\\\\"]",
+        /* 错误 */
+        "", " ", "nul", "nulL", "nullx", "?", "[1,]", "[1 2]", "[1", "[", "{", "{\"a\"", "{\"a\":", "{\"a\":1", "]", ",", ":",
+        "{\"a\" 1}", "{1:2}", "{\"a\":1,}", "{\"a\"::1}", "[\"abc", "\"\\v\"", "\"\\u12\"", "\"a\x01\"", "\"a\\\"",
+        "1 2", "[] x", "[1e309]", "01", "1.", "-", "[1-2]", "[1\"a\"]", "[\"a\"\"b\"]", "\"a\"x", "[true false]",
+        "{\"a\":[1,{\"b\":\"x\" ]}", "\\\"a\"", "[1\\]", "[\f]"
+    };
+    size_t i, len;
+    char* big;
+    value v;
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+        test_indexed_one(cases[i], 130, 1);
+
+    /* 多于一段时分到多个线程, 段的边界落在字符串、转义序列和数字中间 */
+    big = (char*)malloc(3 << 20);
+    len = sprintf(big, "[");
+    for (i = 0; len < (3 << 20) - 200; i++)
+        len += sprintf(big + len, "{\"id\":%u,\"s\":\"%.*s\\\\\\\"\",\"t\":[ true , null ]},", (unsigned)i,
+                       (int)(i % 67), "abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz0123456789");
+    strcpy(big + len - 1, "]");
+    test_indexed_one(big, 2, 4);
+    big[len / 2] = '\x01';  /* 字符串中或字符串外的控制字符 */
+    test_indexed_one(big, 2, 4);
+    free(big);
+
+    /* 嵌套过深 */
+    big = (char*)malloc(4003);
+    memset(big, '[', 2000);
+    memset(big + 2000, ']', 2000);
+    EXPECT_EQ_INT(PARSE_TOO_DEEP, parse_indexed(&v, big, 4000, 1));
+    EXPECT_EQ_INT(EASYJson_NULL, get_type(&v));
+    free(big);
+}
+
+/* tape 中的节点 n 与 v 逐项相同, 顺带检查按下标访问与顺序遍历一致 */
+static int tape_equal(const tape* d, size_t n, const value* v) {
+    size_t i, k, end;
+    if (get_type(d, n) != get_type(v))
+        return 0;
+    switch (get_type(v))
+    {
+    case EASYJson_NUMBER:
+        return get_number(d, n) == get_number(v) && is_int64(d, n) == is_int64(v) && is_uint64(d, n) == is_uint64(v) &&
+               (!is_int64(v) || get_int64(d, n) == get_int64(v)) && (!is_uint64(v) || get_uint64(d, n) == get_uint64(v));
+    case EASYJson_STRING:
+        return get_string_length(d, n) == get_string_length(v) && memcmp(get_string(d, n), get_string(v), get_string_length(v) + 1) == 0;
+    case EASYJson_ARRAY:
+        if (get_array_size(d, n) != get_array_size(v))
+            return 0;
+        for (i = first_child(d, n), end = next_sibling(d, n), k = 0; i != end; i = next_sibling(d, i), k++)
+            if (i != get_array_element(d, n, k) || !tape_equal(d, i, get_array_element(v, k)))
+                return 0;
+        return k == get_array_size(v);
+    case EASYJson_OBJECT:
+        if (get_object_size(d, n) != get_object_size(v))
+            return 0;
+        for (i = first_child(d, n), end = next_sibling(d, n), k = 0; i != end; i = next_sibling(d, i + 2), k++)
+            if (get_object_key_length(d, n, k) != get_object_key_length(v, k) ||
+                memcmp(get_object_key(d, n, k), get_object_key(v, k), get_object_key_length(v, k)) != 0 ||
+                get_object_value(d, n, k) != i + 2 || !tape_equal(d, i + 2, get_object_value(v, k)))
+                return 0;
+        return k == get_object_size(v);
+    default:
+        return 1;
+    }
+}
+
+static void test_parse_tape() {
+    static const char* cases[] = {
+        "null", "true", "false", "-0", "1.5", "-9223372036854775808", "18446744073709551615", "\"\"", "\"a\\u0000b\"",
+        "[]", "{}", "[[[]],{},[{}]]",
+        "{\"n\":null,\"f\":false,\"t\":true,\"i\":123,\"s\":\"abc\\n\",\"a\":[1,2.5,-3],\"o\":{\"1\":1,\"2\":{\"x\":[\"y\"]}},\"e\":[]}"
+    };
+    const char* json = "{\"id\":7,\"tags\":[\"a\",\"b\",{\"c\":null}],\"id\":8,\"last\":true}";
+    size_t i, n;
+    tape d;
+    value v;
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        EXPECT_EQ_INT(PARSE_OK, parse_tape(&d, cases[i], strlen(cases[i])));
+        EXPECT_EQ_INT(PARSE_OK, parse(&v, cases[i]));
+        EXPECT_TRUE(tape_equal(&d, 0, &v));
+        EXPECT_EQ_SIZE_T(d.size, next_sibling(&d, 0));
+        Free(&v);
+        tape_release(&d);
+    }
+
+    EXPECT_EQ_INT(PARSE_OK, parse_tape(&d, json, strlen(json)));
+    n = find_object_value(&d, 0, "id", 2);
+    EXPECT_EQ_INT64(7, get_int64(&d, n));
+    n = find_object_value(&d, 0, "tags", 4);
+    EXPECT_EQ_SIZE_T(3, get_array_size(&d, n));
+    EXPECT_EQ_STRING("b", get_string(&d, get_array_element(&d, n, 1)), get_string_length(&d, get_array_element(&d, n, 1)));
+    n = get_array_element(&d, n, 2);
+    EXPECT_EQ_INT(EASYJson_NULL, get_type(&d, find_object_value(&d, n, "c", 1)));
+    EXPECT_EQ_SIZE_T(KEY_NOT_EXIST, find_object_value(&d, n, "d", 1));
+    EXPECT_TRUE(get_boolean(&d, find_object_value(&d, 0, "last", 4)));
+    EXPECT_EQ_STRING("last", get_object_key(&d, 0, 3), get_object_key_length(&d, 0, 3));
+    tape_release(&d);
+
+    /* 出错时不保留任何内容 */
+    EXPECT_EQ_INT(PARSE_MISS_COMMA_OR_SQUARE_BRACKET, parse_tape(&d, "[1,[\"a\"} ]", 10));
+    EXPECT_TRUE(d.words == nullptr && d.size == 0);
+    EXPECT_EQ_INT(PARSE_ROOT_NOT_SINGULAR, parse_tape(&d, "{} 1", 4));
+    EXPECT_TRUE(d.words == nullptr && d.strings == nullptr);
+    EXPECT_EQ_INT(PARSE_EXPECT_VALUE, parse_tape(&d, "", 0));
+    EXPECT_TRUE(d.words == nullptr);
+}
+
+static void test_parse_lazy() {
+    const char* json = " {\"skip\":{\"s\":\"]}\\\"[{\",\"a\":[[],{}]},\"k\\u0065y\":[1,\"two\",{\"three\":3.5}],\"n\":-12,\"bad\":[1x]} ";
+    lazy root, v, e;
+    value x;
+    char deep[2100];
+    size_t i, len;
+
+    EXPECT_EQ_INT(PARSE_OK, parse_lazy(&root, json, strlen(json)));
+    EXPECT_EQ_INT(EASYJson_OBJECT, get_type(&root));
+
+    /* 跳过的值中的括号和转义引号不影响匹配; 含转义的键也能找到 */
+    EXPECT_EQ_INT(PARSE_OK, find_object_value(&root, "key", 3, &v));
+    EXPECT_EQ_INT(EASYJson_ARRAY, get_type(&v));
+    EXPECT_EQ_INT(PARSE_OK, get_array_element(&v, 1, &e));
+    EXPECT_EQ_INT(EASYJson_STRING, get_type(&e));
+    EXPECT_EQ_INT(PARSE_OK, get_value(&e, &x));
+    EXPECT_EQ_STRING("two", get_string(&x), get_string_length(&x));
+    Free(&x);
+    EXPECT_EQ_INT(PARSE_OK, get_array_element(&v, 2, &e));
+    EXPECT_EQ_INT(PARSE_OK, find_object_value(&e, "three", 5, &e));
+    EXPECT_EQ_INT(PARSE_OK, get_value(&e, &x));
+    EXPECT_EQ_DOUBLE(3.5, get_number(&x));
+    EXPECT_EQ_INT(PARSE_OK, get_array_element(&v, 3, &e));
+    EXPECT_TRUE(e.json == nullptr);
+
+    EXPECT_EQ_INT(PARSE_OK, find_object_value(&root, "n", 1, &v));
+    EXPECT_EQ_INT(PARSE_OK, get_value(&v, &x));
+    EXPECT_EQ_INT64(-12, get_int64(&x));
+    EXPECT_EQ_INT(PARSE_OK, find_object_value(&root, "skip", 4, &v));
+    EXPECT_EQ_INT(PARSE_OK, get_value(&v, &x));
+    EXPECT_EQ_STRING("]}\"[{", get_string(find_object_value(&x, "s", 1)), get_string_length(find_object_value(&x, "s", 1)));
+    Free(&x);
+    EXPECT_EQ_INT(PARSE_OK, find_object_value(&root, "none", 4, &v));
+    EXPECT_TRUE(v.json == nullptr);
+
+    /* 未经检查的部分在取值时才报错 */
+    EXPECT_EQ_INT(PARSE_OK, find_object_value(&root, "bad", 3, &v));
+    EXPECT_EQ_INT(PARSE_OK, get_array_element(&v, 0, &e));
+    EXPECT_EQ_INT(PARSE_INVALID_VALUE, get_value(&e, &x));
+    EXPECT_EQ_INT(EASYJson_NULL, get_type(&x));
+    EXPECT_EQ_INT(PARSE_OK, parse_lazy(&root, "{\"a\" 1,\"b\":2}", 13));
+    EXPECT_EQ_INT(PARSE_MISS_COLON, find_object_value(&root, "b", 1, &v));
+    EXPECT_EQ_INT(PARSE_OK, parse_lazy(&root, "[1 2,3]", 7));
+    EXPECT_EQ_INT(PARSE_MISS_COMMA_OR_SQUARE_BRACKET, get_array_element(&root, 1, &v));
+    EXPECT_EQ_INT(PARSE_OK, parse_lazy(&root, "[1,,3]", 6));
+    EXPECT_EQ_INT(PARSE_EXPECT_VALUE, get_array_element(&root, 1, &v));
+
+    /* parse_lazy 检查的内容 */
+    EXPECT_EQ_INT(PARSE_EXPECT_VALUE, parse_lazy(&root, " ", 1));
+    EXPECT_EQ_INT(PARSE_ROOT_NOT_SINGULAR, parse_lazy(&root, "[] 1", 4));
+    EXPECT_EQ_INT(PARSE_ROOT_NOT_SINGULAR, parse_lazy(&root, "1 2", 3));
+    EXPECT_EQ_INT(PARSE_MISS_QUOTATION_MARK, parse_lazy(&root, "[\"a]", 4));
+    EXPECT_EQ_INT(PARSE_MISS_QUOTATION_MARK, parse_lazy(&root, "\"\\", 2));
+    EXPECT_EQ_INT(PARSE_INVALID_STRING_CHAR, parse_lazy(&root, "[\"\x01\"]", 5));
+    EXPECT_EQ_INT(PARSE_MISS_COMMA_OR_SQUARE_BRACKET, parse_lazy(&root, "[{}", 3));
+    EXPECT_EQ_INT(PARSE_MISS_COMMA_OR_CURLY_BRACKET, parse_lazy(&root, "{\"a\":[]]", 8));
+    EXPECT_TRUE(root.json == nullptr);
+
+    /* 跳过时只数括号, 层数在取值时检查 */
+    memset(deep, '[', 1025);
+    memset(deep + 1025, ']', 1025);
+    EXPECT_EQ_INT(PARSE_OK, parse_lazy(&root, deep, 2050));
+    EXPECT_EQ_INT(PARSE_TOO_DEEP, get_value(&root, &x));
+    EXPECT_EQ_INT(PARSE_OK, parse_lazy(&root, deep + 1, 2048));
+    EXPECT_EQ_INT(PARSE_OK, get_value(&root, &x));
+    Free(&x);
+
+    /* 跳过的字符串与转义落在 64 字节块的各个位置 */
+    for (i = 0; i < 70; i++) {
+        len = (size_t)sprintf(deep, "{\"p\":\"%*s\\\"]}\\\\\",\"x\":[%*s{\"y\":\"[\"}],\"k\":%d}", (int)i, "", (int)(70 - i), "", (int)i);
+        EXPECT_EQ_INT(PARSE_OK, parse_lazy(&root, deep, len));
+        EXPECT_EQ_INT(PARSE_OK, find_object_value(&root, "k", 1, &v));
+        EXPECT_EQ_INT(PARSE_OK, get_value(&v, &x));
+        EXPECT_EQ_INT64((int64_t)i, get_int64(&x));
+        EXPECT_EQ_INT(PARSE_MISS_QUOTATION_MARK, parse_lazy(&root, deep, 8 + i));
+    }
+
+    /* 从上次找到的成员接着找, 到结尾后回到开头 */
+    EXPECT_EQ_INT(PARSE_OK, parse_lazy(&root, "{\"a\":1,\"b\":2,\"c\":3}", 19));
+    EXPECT_EQ_INT(PARSE_OK, find_object_value(&root, "b", 1, &v));
+    EXPECT_TRUE(v.json != nullptr && *v.json == '2');
+    EXPECT_EQ_INT(PARSE_OK, find_object_value(&root, "c", 1, &v));
+    EXPECT_TRUE(v.json != nullptr && *v.json == '3');
+    EXPECT_EQ_INT(PARSE_OK, find_object_value(&root, "a", 1, &v));
+    EXPECT_TRUE(v.json != nullptr && *v.json == '1');
+    EXPECT_EQ_INT(PARSE_OK, find_object_value(&root, "c", 1, &v));
+    EXPECT_TRUE(v.json != nullptr && *v.json == '3');
+    EXPECT_EQ_INT(PARSE_OK, find_object_value(&root, "d", 1, &v));
+    EXPECT_TRUE(v.json == nullptr);
+    EXPECT_EQ_INT(PARSE_OK, find_object_value(&root, "b", 1, &v));
+    EXPECT_TRUE(v.json != nullptr && *v.json == '2');
+}
+
+static void test_parse_depth() {
+    const size_t max = 1024, deep = 1000000;
+    char* json = (char*)malloc(2 * max + 3);
+    stream_parser* sp = stream_parser_create();
+    handler h = {};
+    size_t i, len;
+    value v, *p;
+    char* s;
+
+    /* 恰好 max 层可以解析, 多一层返回 PARSE_TOO_DEEP */
+    len = 0;
+    for (i = 0; i < max; i++)
+        json[len++] = '[';
+    for (i = 0; i < max; i++)
+        json[len++] = ']';
+    json[len] = '\0';
+    EXPECT_EQ_INT(PARSE_OK, parse(&v, json));
+    s = stringify(&v, nullptr);
+    EXPECT_TRUE(strcmp(s, json) == 0);
+    free(s);
+    Free(&v);
+    EXPECT_EQ_INT(PARSE_OK, parse_sax(json, &h, nullptr));
+    feed(sp, json, len);
+    EXPECT_EQ_INT(PARSE_OK, finish(sp, &v));
+    Free(&v);
+
+    memmove(json + 1, json, len + 1);
+    json[len + 1] = ']';
+    json[len + 2] = '\0';
+    TEST_ERROR(PARSE_TOO_DEEP, json);
+    EXPECT_EQ_INT(PARSE_TOO_DEEP, parse_sax(json, &h, nullptr));
+    feed(sp, json, len + 2);
+    EXPECT_EQ_INT(PARSE_TOO_DEEP, finish(sp, &v));
+    stream_parser_destroy(sp);
+    free(json);
+
+    /* 出错时各层已建好的部分都被释放 */
+    TEST_ERROR(PARSE_MISS_KEY, "{\"a\":{1}}");
+    TEST_ERROR(PARSE_MISS_COLON, "{\"a\":[{\"b\":[\"c\",{\"d\"}]}]}");
+    TEST_ERROR(PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "{\"a\":[{\"b\":\"c\"} 1]}");
+
+    /* 不经解析构造的极深的树, Free 与 stringify 不依赖调用栈深度 */
+    init(&v);
+    p = &v;
+    for (i = 0; i < deep; i++) {
+        p->type = EASYJson_ARRAY;
+        p->flags = 0;
+        p->u.a.size = 1;
+        p->u.a.e = (value*)malloc(sizeof(value));
+        p = p->u.a.e;
+        init(p);
+    }
+    s = stringify(&v, &len);
+    EXPECT_EQ_SIZE_T(2 * deep + 4, len);
+    EXPECT_TRUE(s[deep] == 'n' && s[len - 1] == ']');
+    free(s);
+    Free(&v);
+}
+
+static void test_parser_reuse() {
+    const char* json = "{\"a\":[1,2,{\"b\":\"\\u00e9\\n\"}],\"c\":null}";
+    char big[4096];
+    parser p;
+    writer w;
+    value v;
+    char* stack;
+    const char* out;
+    size_t i, len;
+
+    /* 栈在多次解析之间保留, 相同的文档不再重新分配 */
+    parser_init(&p, 0);
+    writer_init(&w, 0);
+    EXPECT_EQ_INT(PARSE_OK, parse(&p, &v, json, strlen(json)));
+    stack = p.stack;
+    EXPECT_TRUE(stack != nullptr);
+    for (i = 0; i < 3; i++) {
+        Free(&v);
+        EXPECT_EQ_INT(PARSE_OK, parse(&p, &v, json, strlen(json)));
+        EXPECT_TRUE(p.stack == stack);
+        out = stringify(&w, &v, &len);
+        EXPECT_EQ_STRING("{\"a\":[1,2,{\"b\":\"\xC3\xA9\\n\"}],\"c\":null}", out, len);
+    }
+    Free(&v);
+    EXPECT_EQ_INT(PARSE_MISS_COMMA_OR_SQUARE_BRACKET, parse(&p, &v, "[1 2]", 5));
+    EXPECT_EQ_INT(EASYJson_NULL, get_type(&v));
+    EXPECT_TRUE(p.stack == stack);
+
+    /* 超过 keep 的栈在调用结束时释放 */
+    parser_release(&p);
+    writer_release(&w);
+    parser_init(&p, 1024);
+    writer_init(&w, 1024);
+    for (i = 0; i < 1000; i++)
+        big[i] = '[';
+    for (; i < 2000; i++)
+        big[i] = ']';
+    EXPECT_EQ_INT(PARSE_OK, parse(&p, &v, big, 2000));
+    EXPECT_TRUE(p.stack == nullptr);
+    out = stringify(&w, &v, &len);
+    EXPECT_TRUE(len == 2000 && memcmp(out, big, len) == 0);
+    Free(&v);
+    EXPECT_EQ_INT(PARSE_OK, parse(&p, &v, json, strlen(json)));
+    EXPECT_TRUE(p.stack != nullptr && p.size <= 1024);
+    out = stringify(&w, &v, &len);
+    EXPECT_TRUE(w.size <= 1024);
+    Free(&v);
+
+    /* 与 arena 一起使用 */
+    arena a;
+    arena_init(&a, big, sizeof(big));
+    EXPECT_EQ_INT(PARSE_OK, parse_arena(&p, &v, json, strlen(json), &a));
+    EXPECT_EQ_SIZE_T(2, get_object_size(&v));
+    EXPECT_TRUE(a.chunks == nullptr);
+    arena_release(&a);
+
+    parser_release(&p);
+    writer_release(&w);
+}
+
+static void test_key_pool() {
+    const char* json = "[{\"id\":1,\"name\":\"a\"},{\"name\":\"b\",\"id\":2},{\"id\":{\"id\":3}}]";
+    key_pool* kp = key_pool_create();
+    const char* id = key_pool_intern(kp, "id", 2);
+    char buf[300];
+    parser p;
+    value v, w;
+    size_t i;
+
+    EXPECT_TRUE(key_pool_intern(kp, "id", 2) == id);
+    EXPECT_EQ_SIZE_T(1, key_pool_size(kp));
+
+    /* 相同的键在多个文档中指向同一份副本 */
+    parser_init(&p, 0);
+    p.keys = kp;
+    EXPECT_EQ_INT(PARSE_OK, parse(&p, &v, json, strlen(json)));
+    EXPECT_EQ_INT(PARSE_OK, parse(&p, &w, json, strlen(json)));
+    EXPECT_EQ_SIZE_T(2, key_pool_size(kp));
+    EXPECT_TRUE(get_object_key(get_array_element(&v, 0), 0) == id);
+    EXPECT_TRUE(get_object_key(get_array_element(&v, 1), 1) == id);
+    EXPECT_TRUE(get_object_key(get_array_element(&v, 0), 1) == get_object_key(get_array_element(&w, 1), 0));
+    EXPECT_TRUE(get_object_key(get_object_value(get_array_element(&v, 2), 0), 0) == id);
+    EXPECT_EQ_DOUBLE(2.0, get_number(find_object_value(get_array_element(&w, 1), "id", 2)));
+    Free(&v);
+    Free(&w);
+
+    /* 出错时已入池的键不被释放 */
+    EXPECT_EQ_INT(PARSE_MISS_COMMA_OR_CURLY_BRACKET, parse(&p, &v, "{\"x\":1 \"y\":2}", 15));
+    EXPECT_TRUE(key_pool_intern(kp, "x", 1) != nullptr);
+    EXPECT_EQ_SIZE_T(3, key_pool_size(kp));
+
+    /* 表扩容后已有的副本保持不变 */
+    for (i = 0; i < 200; i++) {
+        sprintf(buf, "k%u", (unsigned)i);
+        key_pool_intern(kp, buf, strlen(buf));
+    }
+    EXPECT_EQ_SIZE_T(203, key_pool_size(kp));
+    EXPECT_TRUE(key_pool_intern(kp, "id", 2) == id);
+    EXPECT_EQ_STRING("id", id, 2);
+
+    parser_release(&p);
+    key_pool_destroy(kp);
+}
+
+static void test_parse_ndjson() {
+    const char* json = "{\"a\":\"x\\ny\"}\r\n\n  \n[1,\n2]\ntrue\n\t\n\"end\"";
+    ndjson_record* r, *r1;
+    size_t n, n1, i, len, slen, slen1;
+    char* big, *s, *s1;
+    int same;
+    unsigned threads;
+
+    /* 空行跳过, 行号从 1 开始, 字符串中转义的换行不是边界 */
+    EXPECT_EQ_INT(PARSE_EXPECT_VALUE, parse_ndjson(json, strlen(json), &r, &n, 1));
+    EXPECT_EQ_SIZE_T(5, n);
+    EXPECT_EQ_INT(PARSE_OK, r[0].status);
+    EXPECT_EQ_SIZE_T(1, r[0].line);
+    EXPECT_EQ_STRING("x\ny", get_string(get_object_value(&r[0].v, 0)), get_string_length(get_object_value(&r[0].v, 0)));
+    EXPECT_EQ_INT(PARSE_EXPECT_VALUE, r[1].status);
+    EXPECT_EQ_SIZE_T(4, r[1].line);
+    EXPECT_EQ_INT(EASYJson_NULL, get_type(&r[1].v));
+    EXPECT_EQ_INT(PARSE_ROOT_NOT_SINGULAR, r[2].status);
+    EXPECT_EQ_SIZE_T(5, r[2].line);
+    EXPECT_EQ_INT(EASYJson_TRUE, get_type(&r[3].v));
+    EXPECT_EQ_SIZE_T(6, r[3].line);
+    EXPECT_EQ_SIZE_T(8, r[4].line);
+    EXPECT_EQ_STRING("end", get_string(&r[4].v), get_string_length(&r[4].v));
+    free_ndjson(r, n);
+
+    EXPECT_EQ_INT(PARSE_OK, parse_ndjson("", 0, &r, &n, 0));
+    EXPECT_EQ_SIZE_T(0, n);
+    free_ndjson(r, n);
+    EXPECT_EQ_INT(PARSE_OK, parse_ndjson("\n\n", 2, &r, &n, 4));
+    EXPECT_EQ_SIZE_T(0, n);
+    free_ndjson(r, n);
+
+    /* 足够长的输入分到多个线程, 结果与单线程一致 */
+    big = (char*)malloc(1 << 20);
+    for (i = 0, len = 0; len < (1 << 20) - 100; i++)
+        len += sprintf(big + len, i % 997 ? "{\"i\":%u,\"s\":\"\\n%u\"}\n%s" : "[%u,%u\n", (unsigned)i, (unsigned)i, i % 13 ? "" : "\n");
+    EXPECT_EQ_INT(PARSE_MISS_COMMA_OR_SQUARE_BRACKET, parse_ndjson(big, len, &r1, &n1, 1));
+    for (threads = 2; threads <= 8; threads *= 2) {
+        EXPECT_EQ_INT(PARSE_MISS_COMMA_OR_SQUARE_BRACKET, parse_ndjson(big, len, &r, &n, threads));
+        EXPECT_EQ_SIZE_T(n1, n);
+        for (i = 0; i < n && i < n1; i++) {
+            s = stringify(&r[i].v, &slen);
+            s1 = stringify(&r1[i].v, &slen1);
+            same = r[i].status == r1[i].status && r[i].line == r1[i].line && slen == slen1 && memcmp(s, s1, slen) == 0;
+            free(s);
+            free(s1);
+            if (!same)
+                break;
+        }
+        EXPECT_EQ_SIZE_T(n1, i);
+        free_ndjson(r, n);
+    }
+    free_ndjson(r1, n1);
+    free(big);
+}
+
 static void test_parse() {
     test_parse_null();
     test_parse_true();
@@ -466,6 +1805,7 @@ static void test_parse() {
     test_access_boolean();
     test_access_number();
     test_access_string();
+    test_inline_string();
 
     test_parse_invalid_unicode_hex();
     test_parse_invalid_unicode_surrogate();
@@ -476,8 +1816,367 @@ static void test_parse() {
     test_parse_object();
     test_parse_miss_colon();
     test_parse_miss_comma_or_curly_bracket();
+
+    test_parse_arena();
+    test_parse_insitu();
+    test_parse_length();
+    test_parse_whitespace();
+    test_parse_long_string();
+    test_parse_int64();
+    test_access_array();
+    test_access_object();
+    test_find_object();
+    test_pointer();
+    test_parse_sax();
+    test_stream_parser();
+    test_parse_depth();
+    test_parse_indexed();
+    test_parse_tape();
+    test_parse_lazy();
+    test_parser_reuse();
+    test_key_pool();
+    test_parse_ndjson();
+}
+
+#define TEST_EQUAL(json1, json2, equality) \
+    do {\
+        value v1, v2;\
+        init(&v1);\
+        init(&v2);\
+        EXPECT_EQ_INT(PARSE_OK, parse(&v1, json1));\
+        EXPECT_EQ_INT(PARSE_OK, parse(&v2, json2));\
+        EXPECT_EQ_INT(equality, is_equal(&v1, &v2));\
+        EXPECT_EQ_INT(equality, is_equal(&v2, &v1));\
+        Free(&v1);\
+        Free(&v2);\
+    } while(0)
+
+static void test_equal() {
+    char big1[2048], big2[2048];
+    size_t i, n1, n2;
+    value v1, v2;
+    arena a;
+
+    TEST_EQUAL("true", "true", 1);
+    TEST_EQUAL("true", "false", 0);
+    TEST_EQUAL("false", "false", 1);
+    TEST_EQUAL("null", "null", 1);
+    TEST_EQUAL("null", "0", 0);
+    TEST_EQUAL("123", "123", 1);
+    TEST_EQUAL("123", "456", 0);
+    TEST_EQUAL("1", "1.0", 1);
+    TEST_EQUAL("-5", "-5e0", 1);
+    TEST_EQUAL("1", "1.5", 0);
+    TEST_EQUAL("-3", "-3.7", 0);
+    TEST_EQUAL("[1]", "[1.9]", 0);
+    TEST_EQUAL("18446744073709551615", "1.5e19", 0);
+    TEST_EQUAL("15000000000000000000", "1.5e19", 1);
+    TEST_EQUAL("9223372036854775807", "9223372036854775807.5", 0);
+    TEST_EQUAL("9007199254740993", "9007199254740992.0", 0);
+    TEST_EQUAL("18446744073709551615", "1.8446744073709552e19", 0);
+    TEST_EQUAL("9223372036854775808", "-1", 0);
+    TEST_EQUAL("\"abc\"", "\"abc\"", 1);
+    TEST_EQUAL("\"abc\"", "\"abcd\"", 0);
+    TEST_EQUAL("\"a longer string that is not inline\"", "\"a longer string that is not inline\"", 1);
+    TEST_EQUAL("[]", "[]", 1);
+    TEST_EQUAL("[]", "null", 0);
+    TEST_EQUAL("[1,2,3]", "[1,2,3]", 1);
+    TEST_EQUAL("[1,2,3]", "[1,2,3,4]", 0);
+    TEST_EQUAL("[[]]", "[[]]", 1);
+    TEST_EQUAL("[[1],[2]]", "[[1],[3]]", 0);
+    TEST_EQUAL("{}", "{}", 1);
+    TEST_EQUAL("{}", "null", 0);
+    TEST_EQUAL("{}", "[]", 0);
+    TEST_EQUAL("{\"a\":1,\"b\":2}", "{\"a\":1,\"b\":2}", 1);
+    TEST_EQUAL("{\"a\":1,\"b\":2}", "{\"b\":2,\"a\":1}", 1);
+    TEST_EQUAL("{\"a\":1,\"b\":2}", "{\"a\":1,\"b\":3}", 0);
+    TEST_EQUAL("{\"a\":1,\"b\":2}", "{\"a\":1,\"b\":2,\"c\":3}", 0);
+    TEST_EQUAL("{\"a\":1,\"b\":2}", "{\"a\":1,\"c\":2}", 0);
+    TEST_EQUAL("{\"a\":{\"b\":{\"c\":{}}}}", "{\"a\":{\"b\":{\"c\":{}}}}", 1);
+    TEST_EQUAL("{\"a\":{\"b\":{\"c\":{}}}}", "{\"a\":{\"b\":{\"c\":[]}}}", 0);
+    TEST_EQUAL("{\"a\":1,\"a\":2}", "{\"a\":1,\"a\":2}", 1);
+
+    /* 成员多于索引阈值且顺序相反, 一棵在堆上一棵在 arena 中 */
+    n1 = n2 = 0;
+    big1[n1++] = big2[n2++] = '{';
+    for (i = 0; i < 64; i++) {
+        n1 += sprintf(big1 + n1, "%s\"k%zu\":[%zu]", i ? "," : "", i, i);
+        n2 += sprintf(big2 + n2, "%s\"k%zu\":[%zu]", i ? "," : "", 63 - i, 63 - i);
+    }
+    big1[n1++] = big2[n2++] = '}';
+    big1[n1] = big2[n2] = '\0';
+    arena_init(&a, NULL, 0);
+    EXPECT_EQ_INT(PARSE_OK, parse(&v1, big1));
+    EXPECT_EQ_INT(PARSE_OK, parse_arena(&v2, big2, &a));
+    EXPECT_TRUE(is_equal(&v1, &v2));
+    EXPECT_TRUE(is_equal(&v2, &v1));
+    set_number(get_array_element(find_object_value(&v2, "k7", 2), 0), 8);
+    EXPECT_FALSE(is_equal(&v1, &v2));
+    EXPECT_FALSE(is_equal(&v2, &v1));
+    Free(&v1);
+    arena_release(&a);
+
+    /* 比 walk 栈的初始容量更深 */
+    for (i = 0; i < 100; i++)
+        big1[i] = '[', big1[200 - i - 1] = ']';
+    EXPECT_EQ_INT(PARSE_OK, parse(&v1, big1, 200));
+    EXPECT_EQ_INT(PARSE_OK, parse(&v2, big1, 200));
+    EXPECT_TRUE(is_equal(&v1, &v2));
+    Free(&v2);
+    big1[99] = '1';
+    big1[100] = ']';
+    big1[199] = ' ';
+    EXPECT_EQ_INT(PARSE_OK, parse(&v2, big1, 200));
+    EXPECT_FALSE(is_equal(&v1, &v2));
+    Free(&v1);
+    Free(&v2);
 }
 
+static void test_copy() {
+    static const char* json = "{\"t\":true,\"f\":false,\"n\":null,\"d\":1.5,\"i\":-3,\"u\":18446744073709551615,"
+        "\"s\":\"abc\",\"l\":\"a string long enough to be allocated\",\"a\":[1,[2,[]],{}],\"o\":{\"1\":1,\"2\":2}}";
+    char buf[256];
+    value v1, v2;
+    arena a;
+    key_pool* kp = key_pool_create();
+    parser p;
+
+    init(&v2);
+    EXPECT_EQ_INT(PARSE_OK, parse(&v1, json));
+    copy(&v2, &v1);
+    EXPECT_TRUE(is_equal(&v2, &v1));
+    EXPECT_TRUE(get_string(find_object_value(&v2, "l", 1)) != get_string(find_object_value(&v1, "l", 1)));
+    EXPECT_TRUE(get_object_key(&v2, 0) != get_object_key(&v1, 0));
+    EXPECT_TRUE(is_uint64(find_object_value(&v2, "u", 1)));
+    Free(&v1);
+    EXPECT_EQ_STRING("a string long enough to be allocated", get_string(find_object_value(&v2, "l", 1)), 36);
+
+    /* 复制子节点到其祖先 */
+    copy(&v2, find_object_value(&v2, "o", 1));
+    EXPECT_EQ_SIZE_T(2, get_object_size(&v2));
+    EXPECT_EQ_DOUBLE(2.0, get_number(find_object_value(&v2, "2", 1)));
+    Free(&v2);
+
+    /* 借用内存的树复制后完全独立 */
+    arena_init(&a, NULL, 0);
+    EXPECT_EQ_INT(PARSE_OK, parse_arena(&v1, json, &a));
+    copy(&v2, &v1);
+    arena_release(&a);
+    EXPECT_EQ_SIZE_T(10, get_object_size(&v2));
+    EXPECT_EQ_STRING("abc", get_string(find_object_value(&v2, "s", 1)), 3);
+    Free(&v2);
+    strcpy(buf, json);
+    EXPECT_EQ_INT(PARSE_OK, parse_insitu(&v1, buf));
+    copy(&v2, &v1);
+    Free(&v1);
+    memset(buf, 'x', sizeof(buf));
+    EXPECT_EQ_STRING("a string long enough to be allocated", get_string(find_object_value(&v2, "l", 1)), 36);
+    Free(&v2);
+    parser_init(&p, 0);
+    p.keys = kp;
+    EXPECT_EQ_INT(PARSE_OK, parse(&p, &v1, json, strlen(json)));
+    copy(&v2, &v1);
+    Free(&v1);
+    parser_release(&p);
+    key_pool_destroy(kp);
+    EXPECT_EQ_STRING("t", get_object_key(&v2, 0), get_object_key_length(&v2, 0));
+    Free(&v2);
+}
+
+static void test_move() {
+    value v1, v2, v3;
+    EXPECT_EQ_INT(PARSE_OK, parse(&v1, "{\"t\":true,\"a\":[1,2,3],\"o\":{\"1\":1,\"2\":2,\"3\":3}}"));
+    init(&v2);
+    copy(&v2, &v1);
+    init(&v3);
+    move(&v3, &v2);
+    EXPECT_EQ_INT(EASYJson_NULL, get_type(&v2));
+    EXPECT_TRUE(is_equal(&v3, &v1));
+    /* 把子节点移到其祖先 */
+    move(&v3, find_object_value(&v3, "a", 1));
+    EXPECT_EQ_SIZE_T(3, get_array_size(&v3));
+    Free(&v1);
+    Free(&v2);
+    Free(&v3);
+}
+
+static void test_swap() {
+    value v1, v2;
+    init(&v1);
+    init(&v2);
+    set_string(&v1, "Hello", 5);
+    set_string(&v2, "World!", 6);
+    swap(&v1, &v2);
+    EXPECT_EQ_STRING("World!", get_string(&v1), get_string_length(&v1));
+    EXPECT_EQ_STRING("Hello", get_string(&v2), get_string_length(&v2));
+    Free(&v1);
+    Free(&v2);
+}
+
+#ifdef EASYJSON_DOCUMENT
+static void test_document() {
+    Document d, e;
+    size_t i = 0;
+    double sum = 0;
+
+    EXPECT_EQ_INT(PARSE_OK, d.parse("{\"n\":[1,2,3],\"s\":\"Hello\\u0000World\",\"o\":{\"t\":true}}"));
+    EXPECT_EQ_INT(EASYJson_OBJECT, d.root().get_type());
+    EXPECT_EQ_SIZE_T(3, d.root().size());
+    EXPECT_TRUE(d["s"].get_string() == std::string_view("Hello\0World", 11));
+    EXPECT_TRUE(d["o"]["t"].get_boolean());
+    EXPECT_EQ_INT64(2, d["n"][1].get_int64());
+    EXPECT_FALSE(d["none"].get());
+    EXPECT_FALSE(d["o"]["none"] ? 1 : 0);
+
+    for (Value v : d["n"].elements())
+        sum += v.get_number();
+    EXPECT_EQ_DOUBLE(6.0, sum);
+    for (Member m : d.root().members()) {
+        EXPECT_TRUE(m.key == get_object_key(d.get(), i));
+        EXPECT_TRUE(m.value.get() == get_object_value(d.get(), i));
+        i++;
+    }
+    EXPECT_EQ_SIZE_T(3, i);
+
+    /* 移动只转移根节点, 视图仍然有效 */
+    Value n = d["n"];
+    e = std::move(d);
+    EXPECT_TRUE(d.root().is_null());
+    EXPECT_TRUE(e["n"].get() == n.get());
+    Document f(std::move(e));
+    EXPECT_TRUE(e.root().is_null());
+    EXPECT_EQ_SIZE_T(3, f["n"].size());
+
+    /* 修改 */
+    n.pushback().set_string("four");
+    n[0].set_null();
+    f["o"].set("u").set_array();
+    f["o"]["u"].pushback().set_uint64(18446744073709551615ull);
+    f["o"]["t"].set_boolean(false);
+    EXPECT_TRUE(f.stringify() == "{\"n\":[null,2,3,\"four\"],\"s\":\"Hello\\u0000World\",\"o\":{\"t\":false,\"u\":[18446744073709551615]}}");
+
+    Document g = f.copy();
+    EXPECT_TRUE(g == f);
+    g["o"].set("v");
+    EXPECT_FALSE(g == f);
+
+    /* 解析失败时为 null, 原来的树已释放 */
+    EXPECT_EQ_INT(PARSE_MISS_COMMA_OR_SQUARE_BRACKET, f.parse("[1"));
+    EXPECT_TRUE(f.root().is_null());
+}
+
+struct test_address
+{
+    std::string city;
+    uint16_t zip;
+};
+EASYJSON_BIND(test_address, EASYJSON_FIELD(test_address, city), EASYJSON_FIELD(test_address, zip))
+
+struct test_record
+{
+    int64_t id;
+    std::string name;
+    double score;
+    bool active;
+    std::vector<std::string> tags;
+    test_address address;
+    std::optional<std::vector<int>> ranks;
+    std::optional<uint32_t> parent;
+};
+EASYJSON_BIND(test_record, EASYJSON_FIELD(test_record, id), EASYJSON_FIELD(test_record, name),
+              EASYJSON_FIELD(test_record, score), EASYJSON_FIELD(test_record, active),
+              EASYJSON_FIELD(test_record, tags), EASYJSON_FIELD_NAMED(test_record, address, "addr"),
+              EASYJSON_FIELD(test_record, ranks), EASYJSON_FIELD(test_record, parent))
+
+#define PARSE_INTO(out, json) parse_into(out, json, sizeof(json) - 1)
+
+#define TEST_INTO_ERROR(error, expect_field, json)\
+    do {\
+        test_record r;\
+        const char* field = nullptr;\
+        EXPECT_EQ_INT(error, parse_into(&r, json, sizeof(json) - 1, &field));\
+        EXPECT_TRUE(expect_field ? field && strcmp(field, expect_field ? expect_field : "") == 0 : !field);\
+    } while(0)
+
+static void test_parse_into() {
+    test_record r;
+    std::vector<test_address> list;
+    const char json[] = " { \"id\" : -42, \"extra\": {\"a\": [1, {\"b\": null}]}, \"name\": \"A\\u00e9\\\"\","
+        "\"score\": 1.5e2, \"active\": true, \"tags\": [\"x\", \"\"], \"addr\": {\"zip\": 65535, \"city\": \"Z\"},"
+        "\"ranks\": [3, 2, 1], \"parent\": null } ";
+
+    EXPECT_EQ_INT(PARSE_OK, parse_into(&r, json, sizeof(json) - 1));
+    EXPECT_EQ_INT64(-42, r.id);
+    EXPECT_TRUE(r.name == "A\xc3\xa9\"");
+    EXPECT_EQ_DOUBLE(150.0, r.score);
+    EXPECT_TRUE(r.active);
+    EXPECT_TRUE(r.tags.size() == 2 && r.tags[0] == "x" && r.tags[1].empty());
+    EXPECT_TRUE(r.address.city == "Z");
+    EXPECT_EQ_INT(65535, r.address.zip);
+    EXPECT_TRUE(r.ranks && *r.ranks == std::vector<int>({ 3, 2, 1 }));
+    EXPECT_FALSE(r.parent.has_value());
+
+    /* 转义的键按解码后的内容匹配, 可选字段可以缺少, 缺少时不保留上一次的值 */
+    EXPECT_EQ_INT(PARSE_OK, PARSE_INTO(&r, "{\"\\u0069d\":1,\"name\":\"\",\"score\":0,\"active\":false,\"tags\":[],"
+        "\"addr\":{\"city\":\"\",\"zip\":0},\"parent\":4294967295}"));
+    EXPECT_EQ_INT64(1, r.id);
+    EXPECT_FALSE(r.ranks.has_value());
+    EXPECT_TRUE(r.parent && *r.parent == 4294967295u);
+
+    EXPECT_EQ_INT(PARSE_OK, PARSE_INTO(&list, "[{\"city\":\"a\",\"zip\":1},{\"zip\":2,\"city\":\"b\"}]"));
+    EXPECT_TRUE(list.size() == 2 && list[1].city == "b" && list[1].zip == 2);
+    EXPECT_EQ_INT(PARSE_OK, PARSE_INTO(&list, "[]"));
+    EXPECT_TRUE(list.empty());
+
+    std::vector<bool> flags;
+    EXPECT_EQ_INT(PARSE_OK, PARSE_INTO(&flags, "[true, false, true]"));
+    EXPECT_TRUE(flags == std::vector<bool>({ true, false, true }));
+    EXPECT_EQ_INT(PARSE_TYPE_MISMATCH, PARSE_INTO(&flags, "[true, 0]"));
+
+    /* 出错时字段保持原值 */
+    r.active = false;
+    EXPECT_EQ_INT(PARSE_INVALID_VALUE, PARSE_INTO(&r, "{\"active\":tru}"));
+    EXPECT_FALSE(r.active);
+
+    /* 缺少字段与类型不符时报告最内层的字段名 */
+    TEST_INTO_ERROR(PARSE_MISS_FIELD, "id", "{}");
+    TEST_INTO_ERROR(PARSE_MISS_FIELD, "zip", "{\"id\":1,\"name\":\"\",\"score\":0,\"active\":false,\"tags\":[],\"addr\":{\"city\":\"\"}}");
+    TEST_INTO_ERROR(PARSE_TYPE_MISMATCH, "id", "{\"id\":\"1\"}");
+    TEST_INTO_ERROR(PARSE_TYPE_MISMATCH, "id", "{\"id\":1.0}");
+    TEST_INTO_ERROR(PARSE_TYPE_MISMATCH, "id", "{\"id\":9223372036854775808}");
+    TEST_INTO_ERROR(PARSE_TYPE_MISMATCH, "name", "{\"id\":1,\"name\":[\"a\"]}");
+    TEST_INTO_ERROR(PARSE_TYPE_MISMATCH, "tags", "{\"id\":1,\"name\":\"\",\"score\":0,\"active\":false,\"tags\":[1]}");
+    TEST_INTO_ERROR(PARSE_TYPE_MISMATCH, "zip", "{\"addr\":{\"zip\":65536}}");
+    TEST_INTO_ERROR(PARSE_TYPE_MISMATCH, "zip", "{\"addr\":{\"zip\":-1}}");
+    TEST_INTO_ERROR(PARSE_TYPE_MISMATCH, "parent", "{\"parent\":-1}");
+    TEST_INTO_ERROR(PARSE_TYPE_MISMATCH, nullptr, "[]");
+
+    /* 语法错误原样返回, 包括被跳过的值中的错误 */
+    TEST_INTO_ERROR(PARSE_EXPECT_VALUE, nullptr, "");
+    TEST_INTO_ERROR(PARSE_MISS_KEY, nullptr, "{1:2}");
+    TEST_INTO_ERROR(PARSE_MISS_COLON, nullptr, "{\"id\" 1}");
+    TEST_INTO_ERROR(PARSE_MISS_COMMA_OR_CURLY_BRACKET, nullptr, "{\"id\":1 \"name\"}");
+    TEST_INTO_ERROR(PARSE_INVALID_VALUE, nullptr, "{\"other\":[1,tru]}");
+    TEST_INTO_ERROR(PARSE_INVALID_VALUE, "id", "{\"id\":{\"a\":nul}}");
+    TEST_INTO_ERROR(PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "tags", "{\"tags\":[\"a\" \"b\"]}");
+    TEST_INTO_ERROR(PARSE_INVALID_STRING_ESCAPE, "name", "{\"name\":\"\\x\"}");
+
+    /* 跳过的值的嵌套层数与外层合计, 不超过 PARSE_MAX_DEPTH (1024) */
+    const size_t max = 1024;
+    for (size_t k = max - 2; k <= max - 1; k++) {
+        std::string deep = "[{\"other\":" + std::string(k, '[') + std::string(k, ']') + "}]";
+        const char* field = nullptr;
+        EXPECT_EQ_INT(k == max - 2 ? PARSE_MISS_FIELD : PARSE_TOO_DEEP,
+            parse_into(&list, deep.data(), deep.size(), &field));
+        deep = "{\"addr\":{\"zip\":" + std::string(k, '[') + std::string(k, ']') + "}}";
+        EXPECT_EQ_INT(k == max - 2 ? PARSE_TYPE_MISMATCH : PARSE_TOO_DEEP,
+            parse_into(&r, deep.data(), deep.size(), &field));
+        EXPECT_EQ_STRING("zip", field, 3);
+    }
+    EXPECT_EQ_INT(PARSE_ROOT_NOT_SINGULAR, PARSE_INTO(&list, "[] x"));
+}
+#endif
+
 
 int main() {
 #ifdef _WINDOWS
@@ -485,6 +2184,14 @@ int main() {
 #endif
     test_parse();
     test_stringify();
+    test_equal();
+    test_copy();
+    test_move();
+    test_swap();
+#ifdef EASYJSON_DOCUMENT
+    test_document();
+    test_parse_into();
+#endif
     printf("%d/%d (%3.2f%%) passed\n", test_pass, test_count, test_pass * 100.0 / test_count);
     return main_ret;
 }
\ No newline at end of file